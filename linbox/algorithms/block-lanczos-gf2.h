@@ -0,0 +1,144 @@
+/* linbox/algorithms/block-lanczos-gf2.h
+ * Copyright (C) 2020 The LinBox group
+ *
+ * --------------------------------------------
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+
+ * Word-packed block Lanczos iteration over GF2
+ */
+
+#ifndef __LINBOX_block_lanczos_gf2_H
+#define __LINBOX_block_lanczos_gf2_H
+
+#include "linbox/linbox-config.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "linbox/field/gf2.h"
+#include "linbox/blackbox/zo-gf2.h"
+#include "linbox/solutions/methods.h"
+#include "linbox/util/commentator.h"
+
+namespace LinBox
+{
+
+	/** \brief Block Lanczos iteration over GF2, with blocks of 64 vectors.
+	 *
+	 * This is Montgomery's variant of @ref MGBlockLanczosSolver specialized
+	 * to \f$N = 64\f$: an \f$n\times 64\f$ block is a vector of n words,
+	 * \f$64\times 64\f$ matrices are 64 words (word i is row i, bit j is
+	 * column j), inner products and products by \f$64\times 64\f$ matrices go
+	 * through byte-indexed tables, and the matrix is applied with the
+	 * word-parallel ZeroOne<GF2>::applyLeft/applyRight.
+	 *
+	 * The iteration runs on \f$A^T A\f$; the final block \f$V_m\f$ is then
+	 * combined with the computed solutions to get exact solutions of
+	 * \f$Ax = b\f$ or vectors of the nullspace of \f$A\f$.
+	 *
+	 * @bib
+	 * - Peter L. Montgomery, <i>A Block Lanczos Algorithm for Finding
+	 * Dependencies over GF(2)</i>. EUROCRYPT'95, LNCS 921, pp 106--120.
+	 */
+	class BlockLanczosGF2 {
+	public:
+		typedef GF2                    Field;
+		typedef ZeroOne<GF2>           Blackbox;
+		typedef std::vector<uint64_t>  Block;
+
+		/** Constructor
+		 * @param F Field over which to operate
+		 * @param traits Method options: trialsBeforeFailure random restarts
+		 * @param seed Seed of the random starting blocks
+		 */
+		BlockLanczosGF2 (const Field &F, const Method::BlockLanczos &traits,
+				 uint64_t seed = std::random_device()()) :
+			_field (&F), _traits (traits), _generator (seed)
+		{}
+
+		/** Solve the linear system Ax = b.
+		 *
+		 * Computes a random solution when A is singular.
+		 * @return true on success, false if no solution was found
+		 * (probably an inconsistent system)
+		 */
+		template <class Vector1, class Vector2>
+		bool solve (const Blackbox &A, Vector1 &x, const Vector2 &b);
+
+		/** Sample up to 64 independent vectors of the (right) nullspace of A.
+		 *
+		 * @param N Nullspace block, N[j] holds the j-th coordinates
+		 *          of the vectors, vector k being bit k
+		 * @param A Matrix
+		 * @return Number of nullspace vectors found
+		 */
+		size_t sampleNullspace (Block &N, const Blackbox &A);
+
+		//@{ 64x64 and n x 64 block arithmetic
+		/// C = A B, for 64x64 matrices (C may alias A or B)
+		static void mul64 (uint64_t *C, const uint64_t *A, const uint64_t *B);
+		/// W ^= V M, for V, W n x 64 and M 64x64
+		static void mulNx64Acc (Block &W, const Block &V, const uint64_t *M);
+		/// C = V^T W, for V, W n x 64
+		static void innerProduct (uint64_t *C, const Block &V, const Block &W);
+		//@}
+
+	private:
+
+		// W = A^T A V
+		void applySymmetric (Block &W, const Blackbox &A, const Block &V) const;
+
+		// Winv = (S^T T S)^{-1} completed by zeros, S of maximal size
+		// containing the columns not in the previous S
+		size_t nonsingularSub (uint64_t *Winv, size_t *S,
+				       const uint64_t *T, const size_t *lastS, size_t lastDim) const;
+
+		// Montgomery iteration on A^T A X = V0: X accumulates the solution
+		// and V ends up with the last block V_m
+		bool iterate (Block &X, Block &V, const Blackbox &A, const Block &V0) const;
+
+		// Column reduction of [AX | AV] (rows), applying the same
+		// column operations to [X | V]: returns the mask of the combinations
+		// in the nullspace of A, as two words (X part, V part)
+		void combine (uint64_t &nullLo, uint64_t &nullHi,
+			      Block &AX, Block &AV, Block &X, Block &V,
+			      uint64_t &trackLo, uint64_t &trackHi) const;
+
+		void randomBlock (Block &Y, size_t n);
+
+		const Field           *_field;
+		Method::BlockLanczos   _traits;
+		std::mt19937_64        _generator;
+	};
+
+}
+
+#include "linbox/algorithms/block-lanczos-gf2.inl"
+
+#endif // __LINBOX_block_lanczos_gf2_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -0,0 +1,417 @@
+/* linbox/algorithms/block-lanczos-gf2.inl
+ * Copyright (C) 2020 The LinBox group
+ *
+ * --------------------------------------------
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+
+ * Function definitions for block Lanczos iteration over GF2
+ */
+
+#ifndef __LINBOX_block_lanczos_gf2_INL
+#define __LINBOX_block_lanczos_gf2_INL
+
+#include <algorithm>
+#include <cstring>
+#ifdef __LINBOX_USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace LinBox
+{
+
+	inline void BlockLanczosGF2::mul64 (uint64_t *C, const uint64_t *A, const uint64_t *B)
+	{
+		uint64_t T[64];
+		for (size_t i = 0; i < 64; ++i) {
+			uint64_t acc = 0;
+			for (uint64_t w = A[i], k = 0; w; w >>= 1, ++k)
+				if (w & 1) acc ^= B[k];
+			T[i] = acc;
+		}
+		std::memcpy (C, T, sizeof (T));
+	}
+
+	inline void BlockLanczosGF2::mulNx64Acc (Block &W, const Block &V, const uint64_t *M)
+	{
+		// T[j][c] is the combination of rows 8j..8j+7 of M given by byte c
+		std::vector<uint64_t> T (8*256);
+		for (size_t j = 0; j < 8; ++j) {
+			uint64_t *Tj (&T[j*256]);
+			Tj[0] = 0;
+			for (size_t c = 1; c < 256; ++c) {
+				size_t b = 0;
+				while (! ((c >> b) & 1)) ++b;
+				Tj[c] = Tj[c & (c-1)] ^ M[8*j+b];
+			}
+		}
+
+		const long ln ((long)V.size ());
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(static) if (ln > (1<<15))
+#endif
+		for (long r = 0; r < ln; ++r) {
+			const uint64_t v = V[(size_t)r];
+			W[(size_t)r] ^= T[         (v       & 255)] ^ T[ 256 + ((v >>  8) & 255)]
+				^ T[ 512 + ((v >> 16) & 255)] ^ T[ 768 + ((v >> 24) & 255)]
+				^ T[1024 + ((v >> 32) & 255)] ^ T[1280 + ((v >> 40) & 255)]
+				^ T[1536 + ((v >> 48) & 255)] ^ T[1792 + ((v >> 56) & 255)];
+		}
+	}
+
+	inline void BlockLanczosGF2::innerProduct (uint64_t *C, const Block &V, const Block &W)
+	{
+		// T[j][c] accumulates the rows of W whose byte j in V is c
+		std::vector<uint64_t> T (8*256, 0);
+		const long ln ((long)V.size ());
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel if (ln > (1<<15))
+#endif
+		{
+			std::vector<uint64_t> L (8*256, 0);
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp for schedule(static)
+#endif
+			for (long r = 0; r < ln; ++r) {
+				const uint64_t v = V[(size_t)r], w = W[(size_t)r];
+				for (size_t j = 0; j < 8; ++j)
+					L[j*256 + ((v >> (8*j)) & 255)] ^= w;
+			}
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp critical
+#endif
+			for (size_t l = 0; l < T.size (); ++l) T[l] ^= L[l];
+		}
+
+		for (size_t j = 0; j < 8; ++j)
+			for (size_t b = 0; b < 8; ++b) {
+				uint64_t acc = 0;
+				for (size_t c = 1; c < 256; ++c)
+					if ((c >> b) & 1) acc ^= T[j*256+c];
+				C[8*j+b] = acc;
+			}
+	}
+
+	inline void BlockLanczosGF2::applySymmetric (Block &W, const Blackbox &A, const Block &V) const
+	{
+		Block AV;
+		A.applyLeft (AV, V);
+		A.applyRight (W, AV);
+	}
+
+	inline void BlockLanczosGF2::randomBlock (Block &Y, size_t n)
+	{
+		Y.resize (n);
+		for (auto &y : Y) y = _generator ();
+	}
+
+	inline size_t BlockLanczosGF2::nonsingularSub (uint64_t *Winv, size_t *S,
+						       const uint64_t *T, const size_t *lastS, size_t lastDim) const
+	{
+		// M = [T | I]
+		uint64_t M[64][2];
+		for (size_t i = 0; i < 64; ++i) {
+			M[i][0] = T[i];
+			M[i][1] = uint64_t (1) << i;
+		}
+
+		// columns not in the previous S first
+		uint64_t mask = 0;
+		for (size_t i = 0; i < lastDim; ++i) mask |= uint64_t (1) << lastS[i];
+		size_t cols = 0;
+		for (size_t i = 0; i < 64; ++i)
+			if (! ((mask >> i) & 1)) S[cols++] = i;
+		for (size_t i = 0; i < lastDim; ++i) S[cols++] = lastS[i];
+
+		size_t dim = 0;
+		for (size_t i = 0; i < 64; ++i) {
+			const uint64_t bit = uint64_t (1) << S[i];
+			uint64_t *rowi = M[S[i]];
+
+			size_t j = i;
+			for ( ; j < 64; ++j)
+				if (M[S[j]][0] & bit) {
+					std::swap (rowi[0], M[S[j]][0]);
+					std::swap (rowi[1], M[S[j]][1]);
+					break;
+				}
+
+			if (j < 64) {
+				// pivot in T: eliminate its column in the other rows
+				for (j = 0; j < 64; ++j)
+					if ( (M[S[j]] != rowi) && (M[S[j]][0] & bit) ) {
+						M[S[j]][0] ^= rowi[0];
+						M[S[j]][1] ^= rowi[1];
+					}
+				S[dim++] = S[i];
+				continue;
+			}
+
+			// no pivot: use the right half instead and drop the row
+			for (j = i; j < 64; ++j)
+				if (M[S[j]][1] & bit) {
+					std::swap (rowi[0], M[S[j]][0]);
+					std::swap (rowi[1], M[S[j]][1]);
+					break;
+				}
+			if (j == 64) {
+				commentator().report (Commentator::LEVEL_IMPORTANT, INTERNAL_ERROR)
+				<< "Block Lanczos GF2: submatrix is not invertible" << std::endl;
+				return 0;
+			}
+			for (j = 0; j < 64; ++j)
+				if ( (M[S[j]] != rowi) && (M[S[j]][1] & bit) ) {
+					M[S[j]][0] ^= rowi[0];
+					M[S[j]][1] ^= rowi[1];
+				}
+			rowi[0] = rowi[1] = 0;
+		}
+
+		for (size_t i = 0; i < 64; ++i) Winv[i] = M[i][1];
+		return dim;
+	}
+
+	inline bool BlockLanczosGF2::iterate (Block &X, Block &V, const Blackbox &A, const Block &V0) const
+	{
+		commentator().start ("Block Lanczos iteration over GF2", "BlockLanczosGF2::iterate", A.coldim ());
+
+		const size_t n = V0.size ();
+		Block v[3] = { V0, Block (n, 0), Block (n, 0) };
+		Block vnext (n);
+		X.assign (n, 0);
+
+		uint64_t winv[3][64], vtav[2][64], vta2v[2][64];
+		uint64_t vtv0[64], d[64], e[64], f[64], f2[64];
+		std::memset (winv, 0, sizeof (winv));
+		std::memset (vtav, 0, sizeof (vtav));
+		std::memset (vta2v, 0, sizeof (vta2v));
+
+		size_t s[2][64], dim0 = 0, dim1 = 64;
+		for (size_t i = 0; i < 64; ++i) s[1][i] = i;
+		uint64_t mask0, mask1 = ~uint64_t (0);
+
+		innerProduct (vtv0, v[0], V0);
+
+		// about 63.24 dimensions are solved per iteration
+		const size_t maxiter = n/60 + 10;
+		for (size_t iter = 0; ; ++iter) {
+			if (iter > maxiter) {
+				commentator().stop ("too many iterations", NULL, "BlockLanczosGF2::iterate");
+				return false;
+			}
+			commentator().progress ((long)(iter*64));
+
+			applySymmetric (vnext, A, v[0]);
+			innerProduct (vtav[0], v[0], vnext);
+			innerProduct (vta2v[0], vnext, vnext);
+
+			// V_i^T A V_i = 0: the iteration has finished
+			if (std::all_of (vtav[0], vtav[0]+64, [](uint64_t w) { return w == 0; }))
+				break;
+
+			dim0 = nonsingularSub (winv[0], s[0], vtav[0], s[1], dim1);
+			if (dim0 == 0) break;
+
+			mask0 = 0;
+			for (size_t i = 0; i < dim0; ++i) mask0 |= uint64_t (1) << s[0][i];
+			// every column must be used in two consecutive iterations
+			if ((mask0 | mask1) != ~uint64_t (0)) { dim0 = 0; break; }
+
+			// V_{i+1} = A V_i S_i S_i^T + V_i D_{i+1} + V_{i-1} E_{i+1} + V_{i-2} F_{i+1}
+			for (auto &w : vnext) w &= mask0;
+
+			for (size_t i = 0; i < 64; ++i) d[i] = (vta2v[0][i] & mask0) ^ vtav[0][i];
+			mul64 (d, winv[0], d);
+			for (size_t i = 0; i < 64; ++i) d[i] ^= uint64_t (1) << i;
+
+			for (size_t i = 0; i < 64; ++i) e[i] = vtav[0][i] & mask0;
+			mul64 (e, winv[1], e);
+
+			mul64 (f, vtav[1], winv[1]);
+			for (size_t i = 0; i < 64; ++i) f[i] ^= uint64_t (1) << i;
+			mul64 (f, winv[2], f);
+			for (size_t i = 0; i < 64; ++i) f2[i] = ((vta2v[1][i] & mask1) ^ vtav[1][i]) & mask0;
+			mul64 (f, f, f2);
+
+			mulNx64Acc (vnext, v[0], d);
+			mulNx64Acc (vnext, v[1], e);
+			mulNx64Acc (vnext, v[2], f);
+
+			// X += V_i W_i^inv V_i^T V_0
+			mul64 (d, winv[0], vtv0);
+			mulNx64Acc (X, v[0], d);
+
+			std::swap (v[2], v[1]);
+			std::swap (v[1], v[0]);
+			std::swap (v[0], vnext);
+			std::memcpy (winv[2], winv[1], sizeof (winv[1]));
+			std::memcpy (winv[1], winv[0], sizeof (winv[0]));
+			std::memcpy (vtav[1], vtav[0], sizeof (vtav[0]));
+			std::memcpy (vta2v[1], vta2v[0], sizeof (vta2v[0]));
+			std::copy (s[0], s[0]+64, s[1]);
+			dim1 = dim0; mask1 = mask0;
+
+			innerProduct (vtv0, v[0], V0);
+		}
+
+		if (dim0 == 0) {
+			commentator().stop ("breakdown", NULL, "BlockLanczosGF2::iterate");
+			return false;
+		}
+
+		V.swap (v[0]);
+		commentator().stop ("done", NULL, "BlockLanczosGF2::iterate");
+		return true;
+	}
+
+	inline void BlockLanczosGF2::combine (uint64_t &nullLo, uint64_t &nullHi,
+					      Block &AX, Block &AV, Block &X, Block &V,
+					      uint64_t &trackLo, uint64_t &trackHi) const
+	{
+		const size_t m = AX.size ();
+		const long ln ((long)X.size ());
+		uint64_t pivLo = 0, pivHi = 0;
+
+		for (size_t r = 0; r < m; ++r) {
+			const uint64_t liveLo = AX[r] & ~pivLo, liveHi = AV[r] & ~pivHi;
+			if (! (liveLo | liveHi)) continue;
+
+			// pivot column p, to be added to the other live columns of row r
+			const uint64_t pLo = liveLo & (~liveLo + 1);
+			const uint64_t pHi = pLo ? 0 : (liveHi & (~liveHi + 1));
+			const uint64_t mLo = liveLo & ~pLo, mHi = liveHi & ~pHi;
+			pivLo |= pLo; pivHi |= pHi;
+			if (! (mLo | mHi)) continue;
+
+			// p vanishes on the rows above r
+			for (size_t t = r; t < m; ++t)
+				if ( (AX[t] & pLo) | (AV[t] & pHi) ) { AX[t] ^= mLo; AV[t] ^= mHi; }
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(static) if (ln > (1<<15))
+#endif
+			for (long t = 0; t < ln; ++t)
+				if ( (X[(size_t)t] & pLo) | (V[(size_t)t] & pHi) ) {
+					X[(size_t)t] ^= mLo; V[(size_t)t] ^= mHi;
+				}
+			if ( (trackLo & pLo) | (trackHi & pHi) ) { trackLo ^= mLo; trackHi ^= mHi; }
+		}
+
+		nullLo = ~pivLo; nullHi = ~pivHi;
+	}
+
+	template <class Vector1, class Vector2>
+	inline bool BlockLanczosGF2::solve (const Blackbox &A, Vector1 &x, const Vector2 &b)
+	{
+		const size_t n = A.coldim (), m = A.rowdim ();
+		linbox_check (x.size () == n);
+		linbox_check (b.size () == m);
+
+		// b in column 0 of a block
+		Block B (m), AtB;
+		for (size_t i = 0; i < m; ++i) B[i] = b[i] ? 1 : 0;
+		A.applyRight (AtB, B);
+
+		for (size_t trial = 0; trial < _traits.trialsBeforeFailure; ++trial) {
+			// A^T A X = A^T A Y + A^T b e_0^T
+			Block Y, V0, X, V;
+			randomBlock (Y, n);
+			applySymmetric (V0, A, Y);
+			for (size_t j = 0; j < n; ++j) V0[j] ^= AtB[j];
+			if (! iterate (X, V, A, V0)) continue;
+			for (size_t j = 0; j < n; ++j) X[j] ^= Y[j];
+
+			// combinations c of [X | V] with [AX - b e_0^T | AV] c = 0 and c_0 = 1
+			Block AX, AV;
+			A.applyLeft (AX, X);
+			A.applyLeft (AV, V);
+			for (size_t i = 0; i < m; ++i) AX[i] ^= B[i];
+			uint64_t nullLo, nullHi, trackLo = 1, trackHi = 0;
+			combine (nullLo, nullHi, AX, AV, X, V, trackLo, trackHi);
+
+			const uint64_t solLo = nullLo & trackLo, solHi = nullHi & trackHi;
+			if (! (solLo | solHi)) continue;
+			const Block &Z = solLo ? X : V;
+			const uint64_t sol = solLo ? solLo : solHi;
+			size_t q = 0;
+			while (! ((sol >> q) & 1)) ++q;
+			for (size_t j = 0; j < n; ++j) x[j] = ((Z[j] >> q) & 1);
+			return true;
+		}
+
+		return false;
+	}
+
+	inline size_t BlockLanczosGF2::sampleNullspace (Block &N, const Blackbox &A)
+	{
+		const size_t n = A.coldim ();
+
+		for (size_t trial = 0; trial < _traits.trialsBeforeFailure; ++trial) {
+			// A^T A X = A^T A Y, X - Y and V_m span nullspace vectors of A^T A
+			Block Y, V0, X, V;
+			randomBlock (Y, n);
+			applySymmetric (V0, A, Y);
+			if (! iterate (X, V, A, V0)) continue;
+			for (size_t j = 0; j < n; ++j) X[j] ^= Y[j];
+
+			Block AX, AV;
+			A.applyLeft (AX, X);
+			A.applyLeft (AV, V);
+			uint64_t nullLo, nullHi, trackLo = 0, trackHi = 0;
+			combine (nullLo, nullHi, AX, AV, X, V, trackLo, trackHi);
+
+			// the independent non-zero ones are the pivots of
+			// the same reduction on the nullspace combinations
+			for (auto &w : X) w &= nullLo;
+			for (auto &w : V) w &= nullHi;
+			Block none;
+			uint64_t depLo, depHi;
+			combine (depLo, depHi, X, V, none, none, trackLo, trackHi);
+
+			std::vector<std::pair<const Block*,size_t> > columns;
+			for (size_t q = 0; (q < 64) && (columns.size () < 64); ++q)
+				if (! ((depLo >> q) & 1)) columns.emplace_back (&X, q);
+			for (size_t q = 0; (q < 64) && (columns.size () < 64); ++q)
+				if (! ((depHi >> q) & 1)) columns.emplace_back (&V, q);
+			if (columns.empty ()) continue;
+
+			N.assign (n, 0);
+			for (size_t j = 0; j < n; ++j)
+				for (size_t k = 0; k < columns.size (); ++k)
+					N[j] |= (((*columns[k].first)[j] >> columns[k].second) & 1) << k;
+
+			commentator().report (Commentator::LEVEL_NORMAL, PARTIAL_RESULT)
+			<< "Block Lanczos GF2: " << columns.size () << " nullspace vectors" << std::endl;
+			return columns.size ();
+		}
+
+		N.assign (n, 0);
+		return 0;
+	}
+
+}
+
+#endif // __LINBOX_block_lanczos_gf2_INL
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
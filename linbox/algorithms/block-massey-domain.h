@@ -602,7 +602,7 @@ namespace LinBox
 
 			// Compute OrderBasis up to the order length 
             OrderBasis<Field> SB(field());
-            SB.PM_Basis(SigmaBase, PowerSerie, length, shift);
+            SB.PM_Basis_lean(SigmaBase, PowerSerie, length, shift);
 
 
 			// take the m rows which have lowest defect
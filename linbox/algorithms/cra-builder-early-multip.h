@@ -196,6 +196,11 @@ namespace LinBox
 			return CRABuilderEarlySingle<Domain>::terminated();
 		}
 
+		size_t remainingPrimes(double primeLogSize) const
+		{
+			return CRABuilderEarlySingle<Domain>::remainingPrimes(primeLogSize);
+		}
+
 		bool noncoprime(const Integer& i) const
 		{
 			return CRABuilderEarlySingle<Domain>::noncoprime(i);
@@ -41,6 +41,7 @@
 
 #include "linbox/algorithms/lazy-product.h"
 #include "linbox/algorithms/cra-builder-full-multip.h"
+#include "linbox/algorithms/cra-builder-full-multip-tree.h"
 
 
 namespace LinBox
@@ -100,12 +101,14 @@ namespace LinBox
 	/*! NO DOC..
 	 * @ingroup CRA
 	 * Version of LinBox::CRABuilderFullMultip for matrices.
+	 * @tparam Father_Type the vector builder, CRABuilderFullMultip or
+	 * CRABuilderFullMultipTree for large numbers of primes.
 	 */
-	template<class Domain_Type>
-	struct CRABuilderFullMultipMatrix : CRABuilderFullMultip<Domain_Type> {
+	template<class Domain_Type, class Father_Type = CRABuilderFullMultip<Domain_Type> >
+	struct CRABuilderFullMultipMatrix : Father_Type {
 		typedef Domain_Type			Domain;
 		typedef typename Domain::Element 	DomainElement;
-		typedef CRABuilderFullMultipMatrix<Domain> 	Self_t;
+		typedef CRABuilderFullMultipMatrix<Domain,Father_Type> 	Self_t;
 
 		/*! Constructor.
 		 * @param p is a pair such that
@@ -115,7 +118,7 @@ namespace LinBox
 		 * .
 		 */
 		CRABuilderFullMultipMatrix(const std::pair<size_t,double>& p ) :
-			CRABuilderFullMultip<Domain>(p.second, p.first)
+			Father_Type(p.second, p.first)
         { }
 
 		/*! Intialize to the first residue/prime.
@@ -135,6 +138,30 @@ namespace LinBox
 		void progress (const Domain& D, Matrix& e)
 		{ this->progress_iter(D, e.Begin(), this->dimension_); }
 
+		/*! Intialize with the residues modulo a whole batch of primes.
+		 * @param D multimodular domain (eg. MultiModDouble)
+		 * @param e matrix over \p D whose plane \c l, starting at
+		 * <code>e.getPointer(l)</code>, is the residue modulo <code>D.getBase(l)</code>
+		 */
+		template<class MultiDomain, class Matrix>
+		void initializeBatch (const MultiDomain& D, Matrix& e)
+		{
+			this->initialize_iter(D.getBase(0), e.getPointer(0), this->dimension_);
+			for (size_t l = 1; l < D.size(); ++l)
+				this->progress_iter(D.getBase(l), e.getPointer(l), this->dimension_);
+		}
+
+		/*! Add the residues modulo a whole batch of primes.
+		 * @param D multimodular domain
+		 * @param e matrix over \p D, see initializeBatch
+		 */
+		template<class MultiDomain, class Matrix>
+		void progressBatch (const MultiDomain& D, Matrix& e)
+		{
+			for (size_t l = 0; l < D.size(); ++l)
+				this->progress_iter(D.getBase(l), e.getPointer(l), this->dimension_);
+		}
+
 		/*! Compute the result.
 		 * moves low occupied shelves up.
 		 * @param[out] d
@@ -0,0 +1,331 @@
+/* linbox/algorithms/cra-builder-full-multip-tree.h
+ * Copyright (C) 2019 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*!@file algorithms/cra-builder-full-multip-tree.h
+ * @ingroup algorithms
+ * @brief Chinese remaindering of vectors by a subproduct tree.
+ *
+ * The residues are only stored by \c progress; the reconstruction is done
+ * once, by \c result, with a balanced product tree of the moduli shared by
+ * all the entries of the vector.
+ */
+
+#ifndef __LINBOX_cra_full_multip_tree_H
+#define __LINBOX_cra_full_multip_tree_H
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#ifdef __LINBOX_USE_OPENMP
+#include <omp.h>
+#endif
+
+#include "linbox/integer.h"
+
+namespace LinBox
+{
+
+	/** @brief Chinese remaindering of a vector of elements by a subproduct tree.
+	 * @ingroup CRA
+	 *
+	 * Same interface as CRABuilderFullMultip, of which it is a drop-in
+	 * replacement for large numbers of primes: the residues modulo
+	 * \f$m_1,\dots,m_k\f$ are kept and, with \f$M=\prod m_i\f$,
+	 * \f$x = \sum_i (x_i c_i \bmod m_i) M/m_i\f$ where
+	 * \f$c_i = (M/m_i)^{-1} \bmod m_i\f$ is computed for all \f$i\f$ by a
+	 * remainder tree (\f$M \bmod m_i^2 = m_i \cdot (M/m_i \bmod m_i)\f$).
+	 * The sum is then evaluated up the product tree, whose nodes are shared
+	 * by all the entries; entries are processed in parallel with OpenMP.
+	 * The cost is \f$O(\mathsf{M}(\log M)\log k)\f$ per entry instead of the
+	 * quadratic cost of combining the primes one after the other.
+	 *
+	 * The moduli need only be pairwise coprime, they can be Integers.
+	 */
+	template<class Domain_Type>
+	struct CRABuilderFullMultipTree {
+		typedef Domain_Type			Domain;
+		typedef typename Domain::Element DomainElement;
+		typedef CRABuilderFullMultipTree<Domain>		Self_t;
+
+	protected:
+		std::vector<Integer> moduli_; // m_1, ..., m_k
+		std::vector<std::vector<Integer> > residues_; // residues_[i] is the vector modulo m_i
+		const double				LOGARITHMIC_UPPER_BOUND; // log2 of upper bound
+		double totalsize_ = 0.; // log2 of the current modulus
+		size_t dimension_ = 0; // dimension of the vector being reconstructed
+
+		// tree_[0] are the moduli, tree_[t+1][i] = tree_[t][2i] * tree_[t][2i+1]
+		// the tree and the result are caches, filled by the const accessors
+		mutable std::vector<std::vector<Integer> > tree_;
+		mutable std::vector<Integer> result_;
+		mutable bool treeBuilt_ = false;
+		mutable bool reconstructed_ = false;
+
+	public:
+		/** @brief Creates a new vector CRA object.
+		 * @param bnd  upper bound on the logarithm of the result
+		 * @param dim  dimension of the vector to be reconstructed
+		 */
+		CRABuilderFullMultipTree(const double bnd=0.0, size_t dim=0) :
+			LOGARITHMIC_UPPER_BOUND(bnd), dimension_(dim)
+		{}
+
+		Integer& getModulus(Integer& m) const
+		{
+			return m = getModulus();
+		}
+
+		const Integer& getModulus() const
+		{
+			buildTree();
+			return tree_.back().front();
+		}
+
+		//! init
+		template<typename ModType, class Vect>
+		inline void initialize (const ModType& D, const Vect& e)
+		{
+			initialize_iter(D, e.begin(), e.size());
+		}
+
+		template <typename ModType, class Iter>
+		inline void initialize_iter (const ModType& D, Iter e_it, size_t e_size)
+		{
+			moduli_.clear();
+			residues_.clear();
+			totalsize_ = 0;
+			dimension_ = e_size;
+			progress_iter(D, e_it, e_size);
+		}
+
+		template <typename ModType, class Vect>
+		inline void progress (const ModType& D, const Vect& e)
+		{
+			if (e.size() > dimension_) {
+				dimension_ = e.size();
+				for (auto& r : residues_)
+					r.resize(dimension_);
+			}
+			progress_iter(D, e.begin(), e.size());
+		}
+
+		//! Stores the residue, missing values being zeros.
+		template <typename ModType, class Iter>
+		void progress_iter (const ModType& D, Iter e_it, size_t e_size)
+		{
+			treeBuilt_ = reconstructed_ = false;
+			moduli_.emplace_back(mod_to_integer(D));
+			totalsize_ += Givaro::logtwo(moduli_.back());
+			residues_.emplace_back(dimension_);
+			std::copy_n(e_it, e_size, residues_.back().begin());
+		}
+
+		//! result, in the symmetric range
+		inline const std::vector<Integer>& result (bool normalized=true) const
+		{
+			reconstruct();
+			return result_;
+		}
+
+		template <class Vect>
+		inline Vect& result(Vect& r, bool normalized=true) const
+		{
+			r.resize(dimension_);
+			result_iter(r.begin());
+			return r;
+		}
+
+		template <class Iter>
+		void result_iter (Iter r_it, bool normalized=true) const
+		{
+			reconstruct();
+			std::copy_n(result_.begin(), dimension_, r_it);
+		}
+
+		// alias for result
+		inline const std::vector<Integer>& getResidue() const
+		{
+			return result();
+		}
+
+		// alias for result
+		template<class Vect>
+		inline Vect& getResidue(Vect& r) const
+		{
+			return result(r);
+		}
+
+		bool terminated() const
+		{
+			return totalsize_ > LOGARITHMIC_UPPER_BOUND;
+		}
+
+		/** @brief Number of primes of \p primeLogSize bits still needed
+		 * to reach the bound.
+		 */
+		size_t remainingPrimes(double primeLogSize) const
+		{
+			if (terminated()) return 0;
+			return 1 + (size_t)((LOGARITHMIC_UPPER_BOUND - totalsize_) / primeLogSize);
+		}
+
+		bool noncoprime(const Integer& i) const
+		{
+			Integer g;
+			for (auto& m : moduli_)
+				if (gcd(g, i, m) > 1) return true;
+			return false;
+		}
+
+		size_t getDimension() const
+		{ return dimension_; }
+
+		//! number of residues stored
+		size_t size() const
+		{ return moduli_.size(); }
+
+	protected:
+		static inline const integer& mod_to_integer(const Integer& D) {
+			return D;
+		}
+
+		template <class Domain>
+		static inline integer mod_to_integer(const Domain& D) {
+			integer m;
+			D.characteristic(m);
+			return m;
+		}
+
+		//! Builds the product tree of the moduli.
+		void buildTree() const
+		{
+			if (treeBuilt_) return;
+			tree_.assign(1, moduli_);
+			if (moduli_.empty()) tree_[0].emplace_back(1);
+			while (tree_.back().size() > 1) {
+				const std::vector<Integer>& low = tree_.back();
+				std::vector<Integer> up((low.size()+1)/2);
+				const long n((long)low.size()/2);
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(dynamic) if (n > 16)
+#endif
+				for (long i = 0; i < n; ++i)
+					Integer::mul(up[(size_t)i], low[2*(size_t)i], low[2*(size_t)i+1]);
+				if (low.size() & 1) up.back() = low.back();
+				tree_.push_back(std::move(up));
+			}
+			treeBuilt_ = true;
+		}
+
+		/** @brief Cofactor inverses \f$c_i = (M/m_i)^{-1} \bmod m_i\f$,
+		 * by the remainder tree of \f$M\f$ modulo the squares of the nodes.
+		 */
+		void cofactorInverses(std::vector<Integer>& c) const
+		{
+			std::vector<Integer> rem(1, tree_.back().front()), low;
+			for (size_t t = tree_.size()-1; t-- > 0; ) {
+				const std::vector<Integer>& lev = tree_[t];
+				low.resize(lev.size());
+				const long n((long)lev.size());
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(dynamic) if (n > 16)
+#endif
+				for (long i = 0; i < n; ++i) {
+					Integer sq;
+					Integer::mul(sq, lev[(size_t)i], lev[(size_t)i]);
+					Integer::mod(low[(size_t)i], rem[(size_t)i/2], sq);
+				}
+				rem.swap(low);
+			}
+			// rem[i] = M mod m_i^2 = m_i (M/m_i mod m_i)
+			c.resize(moduli_.size());
+			for (size_t i = 0; i < moduli_.size(); ++i) {
+				Integer q;
+				Integer::divexact(q, rem[i], moduli_[i]);
+				inv(c[i], q, moduli_[i]);
+			}
+		}
+
+		//! Reconstructs all the entries, in the symmetric range.
+		void reconstruct() const
+		{
+			if (reconstructed_) return;
+			buildTree();
+			result_.assign(dimension_, Integer(0));
+			const size_t k = moduli_.size();
+			if (k > 0) {
+				std::vector<Integer> c;
+				cofactorInverses(c);
+				const Integer& M = tree_.back().front();
+				Integer halfm(M);
+				--halfm;
+				halfm >>= 1;
+
+				const long dim((long)dimension_);
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel if (dim > 1)
+#endif
+				{
+					std::vector<Integer> x(k);
+					Integer tmp;
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+					for (long j = 0; j < dim; ++j) {
+						// leaves: x_i c_i mod m_i
+						for (size_t i = 0; i < k; ++i) {
+							Integer::mul(tmp, residues_[i][(size_t)j], c[i]);
+							Integer::mod(x[i], tmp, moduli_[i]);
+						}
+						// up the tree: x = x_left * m_right + x_right * m_left
+						for (size_t t = 0; t+1 < tree_.size(); ++t) {
+							const std::vector<Integer>& lev = tree_[t];
+							const size_t n = lev.size()/2;
+							for (size_t i = 0; i < n; ++i) {
+								Integer::mul(tmp, x[2*i], lev[2*i+1]);
+								Integer::axpyin(tmp, x[2*i+1], lev[2*i]);
+								std::swap(x[i], tmp);
+							}
+							if (lev.size() & 1) std::swap(x[n], x[lev.size()-1]);
+						}
+						Integer& r = result_[(size_t)j];
+						Integer::mod(r, x[0], M);
+						if (r < 0) r += M;
+						if (r > halfm) r -= M;
+					}
+				}
+			}
+			reconstructed_ = true;
+		}
+	};
+
+}
+
+#endif //__LINBOX_cra_full_multip_tree_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -238,6 +238,15 @@ namespace LinBox
 			return totalsize_ > LOGARITHMIC_UPPER_BOUND;
 		}
 
+		/** @brief Number of primes of \p primeLogSize bits still needed
+		 * to reach the bound.
+		 */
+		size_t remainingPrimes(double primeLogSize) const
+		{
+			if (terminated()) return 0;
+			return 1 + (size_t)((LOGARITHMIC_UPPER_BOUND - totalsize_) / primeLogSize);
+		}
+
 		bool noncoprime(const Integer& i) const
 		{
             for (auto& shelf : shelves_) {
@@ -440,6 +440,16 @@ namespace LinBox
 		{
 			return occurency_ > EARLY_TERM_THRESHOLD;
 		}
+
+		/** @brief Lower estimate of the number of primes still needed.
+		 *
+		 * Termination needs at least as many more unchanging steps
+		 * as are missing from the current stabilization count.
+		 */
+		size_t remainingPrimes(double) const
+		{
+			return terminated() ? 0 : EARLY_TERM_THRESHOLD + 1 - occurency_;
+		}
 	};
 
 
@@ -32,6 +32,7 @@
 #include "linbox/solutions/methods.h"
 #include <vector>
 #include <utility>
+#include <algorithm>
 #include "linbox/algorithms/cra-builder-single.h"
 #include "linbox/algorithms/cra-builder-full-multip.h"
 #include "linbox/algorithms/lazy-product.h"
@@ -217,6 +218,14 @@ namespace LinBox
 			return ET;
 		}
 
+		size_t remainingPrimes(double primeLogSize) const
+		{
+			size_t r = CRABuilderEarlySingle<Domain>::remainingPrimes(primeLogSize);
+			if (CRABuilderFullMultip<Domain>::LOGARITHMIC_UPPER_BOUND> 1.0)
+				r = std::min(r, CRABuilderFullMultip<Domain>::remainingPrimes(primeLogSize));
+			return r;
+		}
+
 		bool noncoprime(const Integer& i) const {
 			return CRABuilderEarlySingle<Domain>::noncoprime(i);
 		}
@@ -31,6 +31,7 @@
 #include "linbox/field/gmp-rational.h"
 #include "linbox/solutions/methods.h"
 #include <utility>
+#include <algorithm>
 #include "linbox/algorithms/cra-builder-single.h"
 #include "linbox/algorithms/cra-builder-full-multip.h"
 #include "linbox/algorithms/lazy-product.h"
@@ -186,6 +187,14 @@ namespace LinBox
 			return ET;
 		}
 
+		size_t remainingPrimes(double primeLogSize) const
+		{
+			size_t r = CRABuilderEarlySingle<Domain>::remainingPrimes(primeLogSize);
+			if (CRABuilderFullMultip<Domain>::LOGARITHMIC_UPPER_BOUND> 1.0)
+				r = std::min(r, CRABuilderFullMultip<Domain>::remainingPrimes(primeLogSize));
+			return r;
+		}
+
 		bool noncoprime(const Integer& i) const
 		{
 			return CRABuilderEarlySingle<Domain>::noncoprime(i);
@@ -1,9 +1,9 @@
 /* linbox/algorithms/cra-domain-omp.h
  * Copyright (C) 1999-2010 The LinBox group
  *
- * Naive parallel chinese remaindering
- * Launch NN iterations in parallel, where NN=omp_get_max_threads()
- * Then synchronization and termintation test.
+ * Parallel chinese remaindering
+ * Launch as many iterations in parallel as the builder still needs,
+ * with a termination test after each of them.
  * Time-stamp: <13 Mar 12 13:49:58 Jean-Guillaume.Dumas@imag.fr>
  *
  * ========LICENCE========
@@ -38,11 +38,37 @@
 #endif
 #include <omp.h>
 #include <set>
+#include <vector>
+#include <algorithm>
 #include "linbox/algorithms/cra-domain-sequential.h"
 
 namespace LinBox
 {
 
+	namespace Protected {
+		//! Builders without an estimate are fed one round of threads at a time.
+		template<class Builder>
+		inline size_t remainingPrimes(const Builder&, double, ...)
+		{ return 0; }
+
+		template<class Builder>
+		inline auto remainingPrimes(const Builder& B, double logp, int)
+		-> decltype(B.remainingPrimes(logp))
+		{ return B.remainingPrimes(logp); }
+	}
+
+	/*! @brief Parallel (OMP) \ref CRA loop with speculative rounds.
+	 *
+	 * The size of each round is the number of primes the builder still
+	 * needs (its stabilization count for early termination, its bound for
+	 * full multiprecision, see \c remainingPrimes), at most a few per
+	 * thread.  When that leaves threads idle and a prime is cheap
+	 * (less than LINBOX_DEFAULT_CRA_SPECULATIVE_COST seconds, measured
+	 * on the previous iterations), the round is filled up speculatively.
+	 * Residues are given to the builder as soon as they are computed, and
+	 * the iterations of a round not yet started when termination is
+	 * certified are cancelled.
+	 */
 	template<class CRABase>
 	struct ChineseRemainderOMP : public ChineseRemainderSequential<CRABase> {
 		typedef typename CRABase::Domain	Domain;
@@ -58,6 +84,24 @@ namespace LinBox
 			Father_t(b)
 		{}
 
+	protected:
+		size_t nspeculative_ = 0; //!< iterations launched beyond the estimate
+		size_t ncancelled_ = 0;   //!< launched iterations never run
+
+		//! Size of the next round, given the estimate and the measured time of one prime
+		size_t roundSize(size_t NN, size_t need, double cost) const
+		{
+			if (need == 0) return NN;
+			need = std::min(need, 4*NN);
+			if (need < NN && cost < LINBOX_DEFAULT_CRA_SPECULATIVE_COST)
+				return NN;
+			return need;
+		}
+
+	public:
+		size_t speculativeCount() const { return nspeculative_; }
+		size_t cancelledCount() const { return ncancelled_; }
+
 		template <class ResultType, class Function, class PrimeIterator>
 		ResultType& operator() (ResultType& res, Function& Iteration, PrimeIterator& primeiter)
 		{
@@ -67,17 +111,37 @@ namespace LinBox
 			// commentator().start ("Parallel OMP Givaro::Modular iteration", "mmcrait");
 			if (NN == 1) return Father_t::operator()(res,Iteration,primeiter);
 
-			std::vector<Domain> ROUNDdomains; ROUNDdomains.reserve(NN);
-			std::vector<ResidueType> ROUNDresidues; ROUNDresidues.reserve(NN);
-			std::vector<IterationResult> ROUNDresults(NN);
+			// the first residue alone, it also gives the cost of a prime
+			double cost = omp_get_wtime();
+			while (this->ngood_ == 0) {
+				Domain D(*primeiter);
+				++primeiter;
+				auto r = CRAResidue<ResultType,Function>::create(D);
+				if (Iteration(r, D) == IterationResult::SKIP)
+					this->doskip();
+				else {
+					++this->ngood_;
+					this->Builder_.initialize(D, r);
+				}
+			}
+			cost = (omp_get_wtime() - cost) / this->iterCount();
+
+			std::vector<Domain> ROUNDdomains;
+			std::vector<ResidueType> ROUNDresidues;
 			std::set<Integer> coprimeset;
 
 			while (! this->Builder_.terminated()) {
+				const size_t need = Protected::remainingPrimes(this->Builder_, Givaro::logtwo(*primeiter), 0);
+				const size_t round = roundSize(NN, need, cost);
+				if (need && round > need) nspeculative_ += round - need;
+
 				ROUNDdomains.clear();
 				ROUNDresidues.clear();
 				coprimeset.clear();
+				ROUNDdomains.reserve(round);
+				ROUNDresidues.reserve(round);
 
-				while (coprimeset.size() < NN) {
+				while (coprimeset.size() < round) {
 					coprimeset.emplace(this->get_coprime(primeiter));
 					++primeiter;
 				}
@@ -88,39 +152,50 @@ namespace LinBox
 					ROUNDresidues.emplace_back(CRAResidue<ResultType,Function>::create(ROUNDdomains.back()));
 				}
 
-#pragma omp parallel for
-				for(size_t i=0;i<NN;++i) {
-					ROUNDresults[i] = Iteration(ROUNDresidues[i], ROUNDdomains[i]);
-				}
-#pragma omp barrier
-
-				// if any thread says RESTART, then all CONTINUEs become SKIPs
-				bool anyrestart = false;
-				for (auto res : ROUNDresults) {
-					if (res == IterationResult::RESTART) anyrestart = true;
-				}
-				if (anyrestart) {
-					this->nbad_ += this->ngood_;
-					this->ngood_ = 0;
-				}
-
-				for (size_t i = 0; i < NN; ++i) {
-					if (ROUNDresults[i] == IterationResult::SKIP) {
-						this->doskip();
-					}
-					else if (anyrestart && ROUNDresults[i] == IterationResult::CONTINUE) {
-						// commentator should indicate that this prime is bad
-						++this->nbad_;
-					}
-					else if (this->ngood_ == 0) {
-						this->ngood_ = 1;
-						this->Builder_.initialize(ROUNDdomains[i], ROUNDresidues[i]);
-					}
-					else {
-						++this->ngood_;
-						this->Builder_.progress(ROUNDdomains[i], ROUNDresidues[i]);
+				bool done = false;
+				double spent = 0.;
+				size_t ran = 0, skipped = 0;
+				const long lround((long)round);
+#pragma omp parallel for schedule(dynamic,1)
+				for(long i=0;i<lround;++i) {
+					bool cancel;
+#pragma omp atomic read
+					cancel = done;
+					if (cancel) continue;
+
+					double t = omp_get_wtime();
+					IterationResult r = Iteration(ROUNDresidues[(size_t)i], ROUNDdomains[(size_t)i]);
+					t = omp_get_wtime() - t;
+
+#pragma omp critical(LinBoxCRAOMP)
+					{
+						spent += t; ++ran;
+						if (! done) {
+							switch (r) {
+							case IterationResult::CONTINUE:
+								++this->ngood_;
+								this->Builder_.progress(ROUNDdomains[(size_t)i], ROUNDresidues[(size_t)i]);
+								break;
+							case IterationResult::SKIP:
+								++skipped; // doskip may throw, not in here
+								break;
+							case IterationResult::RESTART:
+								this->nbad_ += this->ngood_;
+								this->ngood_ = 1;
+								this->Builder_.initialize(ROUNDdomains[(size_t)i], ROUNDresidues[(size_t)i]);
+								break;
+							}
+							if (this->Builder_.terminated()) {
+#pragma omp atomic write
+								done = true;
+							}
+						}
 					}
 				}
+
+				for ( ; skipped; --skipped) this->doskip();
+				ncancelled_ += round - ran;
+				if (ran) cost = spent / (double)ran;
 				//std::cerr << "Computed: " << iterCount() << " primes." << std::endl;
 			}
 
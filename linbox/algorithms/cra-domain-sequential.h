@@ -34,7 +34,9 @@
 #include "linbox/integer.h"
 #include "linbox/solutions/methods.h"
 #include "linbox/vector/blas-vector.h"
+#include "linbox/field/multimod-field.h"
 #include <utility>
+#include <algorithm>
 #include <stdlib.h>
 #include "linbox/util/commentator.h"
 
@@ -223,6 +225,66 @@ namespace LinBox
 				return ngood_ > 0 && Builder_.terminated();
             }
 
+            /** \brief The \ref CRA loop on batches of primes.
+             *
+             * Same as the \ref CRA loop, but \p Iteration is called once
+             * for \p batch primes at a time: \c Iteration(r, D) gets a
+             * MultiModDouble \p D over these primes and \p r rebound to
+             * it, for instance a <code>BlasMatrix<MultiModDouble></code>
+             * on which BlasMatrixDomain<MultiModDouble> works plane by
+             * plane.  The builder must provide \c initializeBatch and
+             * \c progressBatch (see CRABuilderFullMultipMatrix).
+             * A SKIP or RESTART applies to the whole batch.
+             *
+             * \param[out] res  the reconstructed result
+             * \param Iteration  function object of two arguments
+             * \param primeiter  iterator for generating primes
+             * \param batch  number of primes per call to \p Iteration
+             */
+		template<class ResultType, class Function, class PrimeIterator>
+		ResultType& batch (ResultType& res, Function& Iteration, PrimeIterator& primeiter, size_t batch)
+            {
+                commentator().start ("Multimodular iteration", "mmcrabatch");
+                linbox_check(batch > 0);
+                std::vector<integer> primes;
+                primes.reserve(batch);
+                while (ngood_ == 0 || ! Builder_.terminated()) {
+                    primes.clear();
+                    while (primes.size() < batch) {
+                        integer p(get_coprime(primeiter));
+                        ++primeiter;
+                        if (std::find(primes.begin(), primes.end(), p) == primes.end())
+                            primes.push_back(p);
+                    }
+                    MultiModDouble D(primes);
+                    D.write(commentator().report(Commentator::LEVEL_IMPORTANT, INTERNAL_DESCRIPTION) << "With primes ");
+                    auto r = CRAResidue<ResultType,Function>::create(D);
+
+                    switch (Iteration(r, D)) {
+                    case IterationResult::CONTINUE:
+                        if (ngood_ == 0)
+                            Builder_.initializeBatch(D, r);
+                        else
+                            Builder_.progressBatch(D, r);
+                        ngood_ += (int)batch;
+                        break;
+                    case IterationResult::SKIP:
+                        doskip();
+                        break;
+                    case IterationResult::RESTART:
+                        commentator().report(Commentator::LEVEL_IMPORTANT,INTERNAL_WARNING) << "previous primes were bad; restarting\n";
+                        nbad_ += ngood_;
+                        ngood_ = (int)batch;
+                        Builder_.initializeBatch(D, r);
+                        break;
+                    }
+                }
+
+                Builder_.result(res);
+                commentator().stop ("done", NULL, "mmcrabatch");
+                return res;
+            }
+
 		template<class Param>
 		bool changeFactor(const Param& p)
             {
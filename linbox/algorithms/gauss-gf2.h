@@ -37,6 +37,9 @@
 #include "linbox/vector/vector-domain.h"
 #include "linbox/algorithms/gauss.h"
 #include "linbox/blackbox/zo-gf2.h"
+#include "linbox/solutions/constants.h"
+#include <cstdint>
+#include <vector>
 
 /** @file algorithms/gauss-gf2.h
  * @brief  Gauss elimination and applications for sparse matrices on \f$F_2\f$.
@@ -59,17 +62,26 @@ namespace LinBox
 	public:
 
 		/** \brief The field parameter is the domain  over which to perform computations.
+		 * @param denseSwitch density of the active rows above which the
+		 * elimination goes on with packed dense rows (0 never switches).
 		 */
-		GaussDomain (const Field &) {}
+		GaussDomain (const Field &, double denseSwitch = LINBOX_DEFAULT_DENSE_SWITCH_DENSITY) :
+			_denseSwitch(denseSwitch)
+		{}
 
 		//Copy constructor
 		///
-		GaussDomain (const GaussDomain &)  {}
+		GaussDomain (const GaussDomain &M) :
+			_denseSwitch(M._denseSwitch)
+		{}
 
 		/** accessor for the field of computation.
 		*/
 		const Field &field () const { return *(new GF2()); }
 
+		/// density threshold of the sparse to dense switch
+		double denseSwitch () const { return _denseSwitch; }
+
 		/** @name rank
 		  Callers of the different rank routines
 		  @li  The "in" suffix indicates in place computation
@@ -195,6 +207,18 @@ namespace LinBox
 
 	protected:
 
+		double _denseSwitch;
+
+		// Packs the active rows [k,Ni) into words and returns their rank
+		template <class SparseSeqMatrix>
+		size_t DenseRankBinary (SparseSeqMatrix &A, size_t k, size_t Ni,
+					size_t Rank, size_t Nj) const;
+
+		// Rank of a m x n matrix packed by rows of W words (A is modified),
+		// Gauss-Jordan on blocks of pivots with four Russians table lookups
+		size_t FourRussiansRank (std::vector<uint64_t> &A,
+					 size_t m, size_t n, size_t W) const;
+
 		//-----------------------------------------
 		// Sparse elimination using a pivot row :
 		// lc <-- lc - lc[k]/lp[0] * lp
@@ -239,6 +263,7 @@ namespace LinBox
 #include "linbox/algorithms/gauss/gauss-gf2.inl"
 #include "linbox/algorithms/gauss/gauss-pivot-gf2.inl"
 #include "linbox/algorithms/gauss/gauss-elim-gf2.inl"
+#include "linbox/algorithms/gauss/gauss-dense-gf2.inl"
 #include "linbox/algorithms/gauss/gauss-rank-gf2.inl"
 #include "linbox/algorithms/gauss/gauss-det-gf2.inl"
 #include "linbox/algorithms/gauss/gauss-solve-gf2.inl"
@@ -76,26 +76,34 @@ namespace LinBox
 
 	private:
 		const Field         *_field;
+		double               _denseSwitch;
 
 	public:
 
 		/** \brief The field parameter is the domain
-		 * over which to perform computations
+		 * over which to perform computations.
+		 * Over finite fields, once the density of the remaining active
+		 * submatrix exceeds denseSwitch, the elimination is finished
+		 * by a dense PLUQ factorization (0 never switches).
 		 */
-		GaussDomain (const Field &F) :
-			_field (&F)
+		GaussDomain (const Field &F, double denseSwitch = LINBOX_DEFAULT_DENSE_SWITCH_DENSITY) :
+			_field (&F), _denseSwitch(denseSwitch)
 		{}
 
 		//Copy constructor
 		///
 		GaussDomain (const GaussDomain &Mat) :
-			_field (Mat._field)
+			_field (Mat._field), _denseSwitch(Mat._denseSwitch)
 		{}
 
 		/** accessor for the field of computation
 		*/
 		const Field &field () const { return *_field; }
 
+		/// density threshold of the sparse to dense switch
+		double denseSwitch () const { return _denseSwitch; }
+		double& denseSwitch () { return _denseSwitch; }
+
 		/** @name rank
 		  Callers of the different rank routines\\
 		  -/ The "in" suffix indicates in place computation\\
@@ -231,7 +239,18 @@ namespace LinBox
 						     size_t Ni,
 						     size_t Nj) const;
 
-		// Same as the latter but keeps trace
+		// Structured Gaussian elimination:
+		//   removes singleton rows/columns and merges along weight-2
+		//   columns (Markowitz ordering) before InPlaceLinearPivoting
+		//   on the remaining submatrix.
+		template <class _Matrix>
+		size_t& StructuredPivoting(size_t &rank,
+					   Element& determinant,
+					   _Matrix        &A,
+					   size_t Ni,
+					   size_t Nj) const;
+
+		// Same as InPlaceLinearPivoting but keeps trace
 		//   of column permutations
 		//   of remaining elements in the matrix
 		template <class _Matrix,class Perm>
@@ -371,6 +390,63 @@ Using : FindPivot and LU
 				      size_t Nj) const;
 
 
+		//------------------------------------------
+		// Sparse to dense switch:
+		// the active submatrix, rows k..Ni and columns Rank..Nj,
+		// is factored by FFPACK::PLUQ
+		//------------------------------------------
+		bool denseSwitchReached (const std::vector<size_t> &columns,
+					 size_t Rank, size_t k, size_t Ni, size_t Nj) const;
+
+		// rank and determinant only, the active rows are erased
+		template <class _Matrix>
+		size_t& DenseLinearPivoting(size_t &rank,
+					    Element& determinant,
+					    _Matrix &A,
+					    size_t k,
+					    size_t Ni,
+					    size_t Nj) const;
+
+		// the active rows are replaced by the dense upper factor,
+		// column permutations are applied to P and the upper rows
+		template <class _Matrix, class Perm>
+		size_t& DenseLinearPivoting(size_t &rank,
+					    Element& determinant,
+					    _Matrix &A,
+					    Perm &P,
+					    size_t k,
+					    size_t Ni,
+					    size_t Nj) const;
+
+		template <class _Matrix>
+		BlasMatrix<Field>& DensePLUQ(size_t &R2,
+					     Element& determinant,
+					     BlasMatrix<Field> &Dense,
+					     size_t *P2, size_t *Q2,
+					     _Matrix &A,
+					     size_t Rank,
+					     size_t k,
+					     size_t Ni,
+					     size_t Nj) const;
+
+		template <class _Matrix, bool hasFFLAS>
+		struct DenseSwitch {
+			bool operator()(const GaussDomain& GD,
+					size_t &rank,
+					Element& determinant,
+					_Matrix &A,
+					const std::vector<size_t> &columns,
+					size_t k, size_t Ni, size_t Nj) const;
+			template <class Perm>
+			bool operator()(const GaussDomain& GD,
+					size_t &rank,
+					Element& determinant,
+					_Matrix &A,
+					Perm &P,
+					const std::vector<size_t> &columns,
+					size_t k, size_t Ni, size_t Nj) const;
+		};
+
 		template <class _Matrix, class Perm, bool hasFFLAS>
         struct Continuation {
             size_t& operator()(
@@ -391,6 +467,7 @@ Using : FindPivot and LU
 #include "linbox/algorithms/gauss/gauss.inl"
 #include "linbox/algorithms/gauss/gauss-pivot.inl"
 #include "linbox/algorithms/gauss/gauss-elim.inl"
+#include "linbox/algorithms/gauss/gauss-structured.inl"
 #include "linbox/algorithms/gauss/gauss-solve.inl"
 #include "linbox/algorithms/gauss/gauss-nullspace.inl"
 #include "linbox/algorithms/gauss/gauss-rank.inl"
@@ -0,0 +1,159 @@
+/* linbox/algorithms/gauss/gauss-dense-gf2.inl
+ * Copyright (C) 2020 The LinBox group
+ *
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ *
+ * Sparse to dense switch over GF2:
+ *   the active rows are packed 64 columns per word,
+ *   then reduced by blocks of 8 pivots with the method of four Russians.
+ */
+#ifndef __LINBOX_gauss_dense_gf2_INL
+#define __LINBOX_gauss_dense_gf2_INL
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#ifdef __LINBOX_USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace LinBox
+{
+	template <class SparseSeqMatrix>
+	inline size_t
+	GaussDomain<GF2>::DenseRankBinary (SparseSeqMatrix &LigneA,
+					   size_t k, size_t Ni,
+					   size_t Rank, size_t Nj) const
+	{
+		const size_t m = Ni-k, n = Nj-Rank, W = (n+63)>>6;
+		commentator().report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+		<< "Switching to dense GF2 elimination on " << m << " x " << n << " matrix" << std::endl;
+
+		// active rows have their non-zeroes in columns [Rank,Nj)
+		std::vector<uint64_t> A(m*W, 0);
+		for(size_t i=0; i<m; ++i) {
+			uint64_t * Ai(&A[i*W]);
+			for(const auto& j : LigneA[k+i]) {
+				const size_t c = (size_t)j-Rank;
+				Ai[c>>6] |= uint64_t(1) << (c & 63);
+			}
+			LigneA[k+i].clear();
+		}
+
+		return FourRussiansRank(A, m, n, W);
+	}
+
+	inline size_t
+	GaussDomain<GF2>::FourRussiansRank (std::vector<uint64_t> &A,
+					    size_t m, size_t n, size_t W) const
+	{
+		// Pivots are searched by blocks of K columns, aligned on bytes
+		// so that the block always lies within a single word.
+		const size_t K = 8, TS = size_t(1) << K;
+		std::vector<uint64_t> table(TS*W);
+		std::vector<size_t> keys(TS);
+		size_t r = 0;
+
+		for(size_t col = 0; (col < n) && (r < m); col += K) {
+			const size_t w0 = col >> 6, shift = col & 63, width = W-w0;
+			const size_t kb = std::min(K, n-col);
+			auto window = [&](size_t i) { return (size_t)((A[i*W+w0] >> shift) & (TS-1)); };
+			auto rowxor = [&](size_t dst, const uint64_t * src) {
+				uint64_t * Ad(&A[dst*W+w0]);
+				for(size_t l=0; l<width; ++l) Ad[l] ^= src[l];
+			};
+
+			// Gaussian elimination on the block columns:
+			// the pivot rows are kept reduced with each other
+			const size_t r0 = r;
+			size_t np = 0, pivcols[K], pivwin[K];
+			for(size_t c = 0; (c < kb) && (r < m); ++c) {
+				size_t i = r, win = 0;
+				for( ; i < m; ++i) {
+					win = window(i);
+					for(size_t t=0; t<np; ++t)
+						if ( (win >> pivcols[t]) & 1 ) win ^= pivwin[t];
+					if ( (win >> c) & 1 ) break;
+				}
+				if (i == m) continue;
+
+				win = window(i);
+				for(size_t t=0; t<np; ++t)
+					if ( (win >> pivcols[t]) & 1 ) rowxor(i, &A[(r0+t)*W+w0]);
+				if (i != r)
+					std::swap_ranges(A.begin()+(ptrdiff_t)(i*W+w0), A.begin()+(ptrdiff_t)(i*W+W),
+							 A.begin()+(ptrdiff_t)(r*W+w0));
+				for(size_t t=0; t<np; ++t)
+					if ( (pivwin[t] >> c) & 1 ) {
+						rowxor(r0+t, &A[r*W+w0]);
+						pivwin[t] = window(r0+t);
+					}
+				pivcols[np] = c;
+				pivwin[np] = window(r);
+				++np; ++r;
+			}
+			if ( (np == 0) || (r == m) ) continue;
+
+			// Table of all the combinations of the pivot rows
+			// and map from the block bits to the combination clearing them
+			const size_t nt = size_t(1) << np;
+			std::fill(table.begin(), table.begin()+(ptrdiff_t)width, uint64_t(0));
+			for(size_t key=1; key<nt; ++key) {
+				size_t t = 0;
+				while (! ((key >> t) & 1) ) ++t;
+				const uint64_t * prev(&table[(key ^ (size_t(1) << t))*width]);
+				const uint64_t * piv(&A[(r0+t)*W+w0]);
+				uint64_t * cur(&table[key*width]);
+				for(size_t l=0; l<width; ++l) cur[l] = prev[l] ^ piv[l];
+			}
+			for(size_t win=0; win<TS; ++win) {
+				keys[win] = 0;
+				for(size_t t=0; t<np; ++t)
+					keys[win] |= ( (win >> pivcols[t]) & 1 ) << t;
+			}
+
+			// Reduction of the remaining rows, one lookup per row
+			const long lm((long)m);
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(static) if ((m-r)*width > (1<<14))
+#endif
+			for(long i=(long)r; i<lm; ++i) {
+				const size_t key = keys[window((size_t)i)];
+				if (key) rowxor((size_t)i, &table[key*width]);
+			}
+		}
+
+		commentator().report (Commentator::LEVEL_NORMAL, PARTIAL_RESULT)
+		<< "Dense GF2 rank : " << r << std::endl;
+		return r;
+	}
+
+} // namespace LinBox
+
+#endif // __LINBOX_gauss_dense_gf2_INL
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
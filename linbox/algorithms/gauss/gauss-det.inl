@@ -41,6 +41,8 @@ namespace LinBox
 		size_t Rank;
 		if (reord == PivotStrategy::None)
 			NoReordering(Rank, determinant, A,  Ni, Nj);
+		else if (reord == PivotStrategy::Structured)
+			StructuredPivoting(Rank, determinant, A, Ni, Nj);
 		else
 			InPlaceLinearPivoting(Rank, determinant, A, Ni, Nj);
 		return determinant;
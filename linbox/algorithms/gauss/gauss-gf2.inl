@@ -29,6 +29,7 @@
 
 #include "linbox/algorithms/gauss.h"
 #include "linbox/util/commentator.h"
+#include <algorithm>
 #include <utility>
 
 #ifdef __LINBOX_ALL__ //BB: ???
@@ -88,12 +89,24 @@ namespace LinBox
 #else
 		long sstep = 1000;
 #endif
+		// Frequency of the sparse to dense switch test
+		const long dstep = std::max(1L, (long)Nj >> 6);
+		bool densified = false;
+
 		// Elimination steps with reordering
 
 		typename SparseSeqMatrix::iterator LigneA_k = LigneA.begin();
 		for (long k = 0; k < last; ++k, ++LigneA_k) {
 			long p = k, s = 0;
 
+			// Once dense enough, the remaining rank is computed on packed rows:
+			// P then no longer tracks the column permutations of the remaining rows
+			if ( (! (k % dstep)) && Protected::denseSwitchReached(_denseSwitch, col_density, Rank, (size_t)k, Ni, Nj) ) {
+				Rank += DenseRankBinary(LigneA, (size_t)k, Ni, Rank, Nj);
+				densified = true;
+				break;
+			}
+
 #ifdef __LINBOX_FILLIN__
 			if ( ! (k % 100) )
 #else
@@ -163,8 +176,8 @@ namespace LinBox
 			// LigneA.write(rep << "U:= ", Tag::FileFormat::Maple) << std::endl;
 		}//for k
 
-		SparseFindPivotBinary ( LigneA[(size_t)last], Rank, c, determinant);
-		if (c != -1) {
+		if (! densified) SparseFindPivotBinary ( LigneA[(size_t)last], Rank, c, determinant);
+		if ( (! densified) && (c != -1) ) {
 			if ( c != (static_cast<long>(Rank)-1) ) {
 				P.permute(Rank-1,(size_t)c);
 				for (long ll=0      ; ll < last ; ++ll)
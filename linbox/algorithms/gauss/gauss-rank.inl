@@ -41,6 +41,8 @@ namespace LinBox
 		Element determinant;
 		if (reord == PivotStrategy::None)
 			return NoReordering(Rank, determinant, A,  Ni, Nj);
+		else if (reord == PivotStrategy::Structured)
+			return StructuredPivoting(Rank, determinant, A, Ni, Nj);
 		else
 			return InPlaceLinearPivoting(Rank, determinant, A, Ni, Nj);
 	}
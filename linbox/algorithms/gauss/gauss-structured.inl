@@ -0,0 +1,301 @@
+/* linbox/algorithms/gauss/gauss-structured.inl
+ * Copyright (C) 2020 The LinBox group
+ *
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ *
+ * Structured Gaussian elimination pre-pass:
+ *   singleton columns and rows are pivoted at no cost,
+ *   weight-2 columns are merged into their heavier row,
+ *   candidates being processed by increasing Markowitz cost.
+ * The remaining submatrix is then given to InPlaceLinearPivoting.
+ */
+#ifndef __LINBOX_gauss_structured_INL
+#define __LINBOX_gauss_structured_INL
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <tuple>
+#include <vector>
+
+#include "linbox/solutions/constants.h"
+
+namespace LinBox { namespace Protected {
+
+	// Positions of the remaining indices, after some removals
+	// (Fenwick tree: the sign of a Laplace expansion needs them).
+	class RemainingPositions {
+		std::vector<long> _tree;
+	public:
+		RemainingPositions(size_t n) :
+			_tree(n+1,0)
+		{
+			for(size_t i=1; i<=n; ++i) {
+				++_tree[i];
+				size_t p = i + (i & (~i+1));
+				if (p <= n) _tree[p] += _tree[i];
+			}
+		}
+
+		// number of remaining indices strictly before i
+		size_t position(size_t i) const
+		{
+			long s=0;
+			for(size_t p=i; p>0; p -= (p & (~p+1)))
+				s += _tree[p];
+			return (size_t)s;
+		}
+
+		void remove(size_t i)
+		{
+			for(size_t p=i+1; p<_tree.size(); p += (p & (~p+1)))
+				--_tree[p];
+		}
+	};
+
+} // namespace Protected
+} // namespace LinBox
+
+namespace LinBox
+{
+	template <class _Field>
+	template <class _Matrix> size_t&
+	GaussDomain<_Field>::StructuredPivoting(size_t &Rank,
+						Element& determinant,
+						_Matrix        &LigneA,
+						size_t  Ni,
+						size_t  Nj) const
+	{
+		typedef typename _Matrix::Row        Vector;
+		typedef typename Vector::value_type E;
+		// (Markowitz cost, pivot row, pivot column)
+		typedef std::tuple<size_t,size_t,size_t> Candidate;
+
+		commentator().start ("Structured Gaussian elimination pre-pass", "SGE", Ni);
+
+		const size_t maxcost = LINBOX_DEFAULT_STRUCTURED_MAX_COST;
+
+		Rank = 0;
+		field().assign(determinant, field().one);
+
+		// rows of each column, with lazy deletion:
+		//   may contain dead rows, rows no longer having the column, duplicates
+		std::vector<std::vector<size_t> > columns(Nj);
+		std::vector<size_t> colweight(Nj,0);
+		for(size_t i=0; i<Ni; ++i)
+			for(const auto& e : LigneA[i]) {
+				columns[e.first].push_back(i);
+				++colweight[e.first];
+			}
+
+		std::vector<bool> deadrow(Ni,false), deadcol(Nj,false);
+		Protected::RemainingPositions rowpos(Ni), colpos(Nj);
+		std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate> > candidates;
+
+		auto findEntry = [&LigneA](size_t i, size_t j) {
+			return std::lower_bound(LigneA[i].begin(), LigneA[i].end(), j,
+						[](const E& e, size_t c) { return e.first < c; });
+		};
+		auto hasEntry = [&LigneA,&findEntry](size_t i, size_t j) {
+			auto it = findEntry(i,j);
+			return (it != LigneA[i].end()) && (it->first == j);
+		};
+
+		// Cleans the row list of column j
+		auto liveRows = [&](size_t j) -> std::vector<size_t>& {
+			auto& col = columns[j];
+			std::sort(col.begin(), col.end());
+			col.erase(std::unique(col.begin(), col.end()), col.end());
+			col.erase(std::remove_if(col.begin(), col.end(),
+						 [&](size_t i) { return deadrow[i] || !hasEntry(i,j); }),
+				  col.end());
+			return col;
+		};
+		// Enqueues a light column
+		auto considerColumn = [&](size_t j) {
+			if (deadcol[j] || (colweight[j] == 0) || (colweight[j] > 2)) return;
+			const auto& col = liveRows(j);
+			if (col.size() == 1)
+				candidates.emplace(0, col[0], j);
+			else {
+				size_t i = (LigneA[col[0]].size() <= LigneA[col[1]].size() ? col[0] : col[1]);
+				size_t cost = LigneA[i].size()-1;
+				if (cost <= maxcost)
+					candidates.emplace(cost, i, j);
+			}
+		};
+		auto considerRow = [&](size_t i) {
+			if (!deadrow[i] && (LigneA[i].size() == 1))
+				candidates.emplace(0, i, LigneA[i][0].first);
+		};
+
+		// Removes row i and column j, pivot A[i,j] being the only
+		// remaining entry in its row or in its column
+		auto pivot = [&](size_t i, size_t j, const Element& a) {
+			field().mulin(determinant, a);
+			if ( (rowpos.position(i) + colpos.position(j)) & 1 )
+				field().negin(determinant);
+			rowpos.remove(i); colpos.remove(j);
+			deadrow[i] = true; deadcol[j] = true;
+			for(const auto& e : LigneA[i])
+				if (e.first != j) {
+					--colweight[e.first];
+					considerColumn(e.first);
+				}
+			LigneA[i].clear();
+			++Rank;
+		};
+
+		for(size_t j=0; j<Nj; ++j) considerColumn(j);
+		for(size_t i=0; i<Ni; ++i) considerRow(i);
+
+		size_t merges = 0;
+		std::vector<size_t> touched;
+		while (! candidates.empty()) {
+			size_t cost, i, j;
+			std::tie(cost, i, j) = candidates.top();
+			candidates.pop();
+			if (deadrow[i] || deadcol[j]) continue;
+			auto it = findEntry(i,j);
+			if ( (it == LigneA[i].end()) || (it->first != j) ) {
+				considerColumn(j);
+				continue;
+			}
+			Element a; field().assign(a, it->second);
+
+			if (LigneA[i].size() == 1) {
+				// Singleton row: the other entries of column j do not matter
+				for(const size_t r : liveRows(j))
+					if (r != i) {
+						LigneA[r].erase(findEntry(r,j));
+						considerRow(r);
+					}
+				colweight[j] = 1;
+				pivot(i, j, a);
+			}
+			else if (colweight[j] == 1) {
+				// Singleton column
+				pivot(i, j, a);
+			}
+			else if (colweight[j] == 2) {
+				const auto& col = liveRows(j);
+				const size_t r = (col[0] == i ? col[1] : col[0]);
+				const size_t current = LigneA[i].size()-1;
+				if (LigneA[r].size() < LigneA[i].size()) {
+					considerColumn(j);
+					continue;
+				}
+				if (current != cost) {
+					if (current <= maxcost) candidates.emplace(current, i, j);
+					continue;
+				}
+
+				// A[r] <-- A[r] - A[r,j]/A[i,j] * A[i]
+				Element coef;
+				field().div(coef, findEntry(r,j)->second, a);
+				field().negin(coef);
+				Vector construit; construit.reserve(LigneA[r].size()+LigneA[i].size());
+				touched.resize(0);
+				auto pi = LigneA[i].begin(), pr = LigneA[r].begin();
+				while ( (pi != LigneA[i].end()) || (pr != LigneA[r].end()) ) {
+					if ( (pr == LigneA[r].end())
+					     || ( (pi != LigneA[i].end()) && (pi->first < pr->first) ) ) {
+						if (pi->first != j) {
+							Element tmp; field().mul(tmp, coef, pi->second);
+							construit.push_back(E(pi->first, tmp));
+							++colweight[pi->first];
+							columns[pi->first].push_back(r);
+						}
+						++pi;
+					}
+					else if ( (pi == LigneA[i].end()) || (pr->first < pi->first) ) {
+						construit.push_back(*pr);
+						++pr;
+					}
+					else {
+						if (pi->first != j) {
+							Element tmp;
+							field().axpy(tmp, coef, pi->second, pr->second);
+							if (field().isZero(tmp)) {
+								--colweight[pi->first];
+								touched.push_back(pi->first);
+							}
+							else
+								construit.push_back(E(pi->first, tmp));
+						}
+						++pi; ++pr;
+					}
+				}
+				--colweight[j];
+				std::swap(LigneA[r], construit);
+				++merges;
+
+				pivot(i, j, a);
+				for(const size_t c : touched) considerColumn(c);
+				considerRow(r);
+			}
+		}
+
+		commentator().report (Commentator::LEVEL_NORMAL, PARTIAL_RESULT)
+		<< "Pre-pass pivots: " << Rank << " (" << merges << " merges)" << std::endl;
+
+		// Compact the remaining rows and columns,
+		// monotone renumbering keeps the rows sorted
+		std::vector<size_t> colmap(Nj);
+		size_t nc=0;
+		for(size_t j=0; j<Nj; ++j)
+			if (! deadcol[j]) colmap[j] = nc++;
+		size_t nr=0;
+		for(size_t i=0; i<Ni; ++i)
+			if (! deadrow[i]) {
+				for(auto& e : LigneA[i]) e.first = colmap[e.first];
+				if (nr != i) std::swap(LigneA[nr], LigneA[i]);
+				++nr;
+			}
+
+		if ( (nr > 0) && (nc > 0) ) {
+			size_t rank1; Element det1;
+			InPlaceLinearPivoting(rank1, det1, LigneA, nr, nc);
+			Rank += rank1;
+			field().mulin(determinant, det1);
+		}
+		if ( (Rank < Ni) || (Rank < Nj) )
+			field().assign(determinant, field().zero);
+
+		commentator().report (Commentator::LEVEL_NORMAL, PARTIAL_RESULT)
+		<< "Rank : " << Rank
+		<< " over GF (" << field().characteristic() << ")" << std::endl;
+		commentator().stop ("done", 0, "SGE");
+
+		return Rank;
+	}
+
+} // namespace LinBox
+
+#endif // __LINBOX_gauss_structured_INL
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -45,14 +45,9 @@
 #define __LINBOX_FILLIN__
 #endif
 
-#ifdef __LINBOX_SpD_SWITCH__
 #include <linbox/matrix/dense-matrix.h>
+#include <linbox/blackbox/permutation.h>
 #include <numeric>
-#  ifndef __LINBOX_SpD_MAXSPARSITY__
-// Sparsity less than 1% --> switch to dense
-#  define __LINBOX_SpD_MAXSPARSITY__ 0.01
-#  endif
-#endif
 
 namespace LinBox
 {
@@ -123,20 +118,19 @@ namespace LinBox
 #  endif
 #endif
 
+        // Frequency of the sparse to dense switch test
+        const long dstep = std::max(1L, (long)Nj >> 6);
+
         // Elimination steps with reordering
 
         typename _Matrix::RowIterator LigneA_k = LigneA.rowBegin();
         for (long k = 0; k < last; ++k, ++LigneA_k) {
 
-#ifdef __LINBOX_SpD_MAXSPARSITY__
-
-            if (accumulate(col_density.begin()+Rank,col_density.end(),0)>(Ni*Nj*__LINBOX_SpD_MAXSPARSITY__)) {
-#  ifdef _LB_DEBUG
-                std::cerr << "Dense switch: " << accumulate(col_density.begin()+Rank,col_density.end(),0) << '>' << Ni << '*' << Nj << '*' << __LINBOX_SpD_MAXSPARSITY__ << std::endl;
-#  endif
-                degeneratedense=std::is_base_of<Givaro::FiniteRingInterface<Element>,_Field>::value && true; break;
+            if ( std::is_base_of<Givaro::FiniteRingInterface<Element>,_Field>::value
+                 && (! (k % dstep))
+                 && denseSwitchReached(col_density, Rank, (size_t)k, Ni, Nj) ) {
+                degeneratedense=true; break;
             }
-#endif
 
             long p = k, s = 0;
 
@@ -466,6 +460,177 @@ namespace LinBox
     }
 
 
+    namespace Protected {
+        // Is the density of the active submatrix, rows k..Ni and columns
+        // Rank..Nj, above the threshold (0 never switches)?
+        // Shared by the generic and the GF2 eliminations.
+        inline bool denseSwitchReached (double threshold,
+                                        const std::vector<size_t> &columns,
+                                        size_t Rank, size_t k,
+                                        size_t Ni, size_t Nj)
+        {
+            if ( (threshold <= 0.) || (k >= Ni) || (Rank >= Nj) ) return false;
+            // columns holds the number of non-zeroes of the active rows
+            const size_t nnz = std::accumulate(columns.begin()+(ptrdiff_t)Rank, columns.end(), size_t(0));
+            return double(nnz) > threshold * double(Ni-k) * double(Nj-Rank);
+        }
+    }
+
+    template <class _Field>
+    inline bool
+    GaussDomain<_Field>::denseSwitchReached (const std::vector<size_t> &columns,
+                                             size_t Rank, size_t k,
+                                             size_t Ni, size_t Nj) const
+    {
+        return Protected::denseSwitchReached(_denseSwitch, columns, Rank, k, Ni, Nj);
+    }
+
+    template <class _Field>
+    template <class _Matrix> inline BlasMatrix<_Field>&
+    GaussDomain<_Field>::DensePLUQ (size_t &R2,
+                                    Element &determinant,
+                                    BlasMatrix<_Field> &A,
+                                    size_t *P2, size_t *Q2,
+                                    _Matrix &LigneA,
+                                    size_t Rank,
+                                    size_t k,
+                                    size_t Ni,
+                                    size_t Nj) const
+    {
+        const size_t sNi=Ni-k, sNj=Nj-Rank;
+        commentator().report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+        << "Dense switch: " << sNi << 'x' << sNj << " at rank " << Rank << std::endl;
+
+        // Active rows only have non-zeroes in columns Rank..Nj
+        for(size_t di=k;di<Ni;++di) {
+            for(size_t dj=0;dj<LigneA[di].size();++dj)
+                A.setEntry(di-k,LigneA[di][dj].first-Rank, LigneA[di][dj].second);
+            LigneA[di].resize(0);
+        }
+
+        for (size_t j=0;j<sNi;j++) P2[j]=0;
+        for (size_t j=0;j<sNj;j++) Q2[j]=0;
+        R2 = FFPACK::PLUQ(this->field(), FFLAS::FflasNonUnit, sNi, sNj, A.getPointer(), sNj, P2, Q2);
+
+        for(size_t i=0; i<R2; ++i)
+            this->field().mulin(determinant,A.getEntry(i,i));
+        for (size_t i=0;i<sNi;++i)
+            if(i != P2[i]) this->field().negin(determinant);
+        for (size_t j=0;j<sNj;++j)
+            if(j != Q2[j]) this->field().negin(determinant);
+
+        return A;
+    }
+
+    template <class _Field>
+    template <class _Matrix> inline size_t&
+    GaussDomain<_Field>::DenseLinearPivoting (size_t &Rank,
+                                              Element &determinant,
+                                              _Matrix &LigneA,
+                                              size_t k,
+                                              size_t Ni,
+                                              size_t Nj) const
+    {
+        const size_t sNi=Ni-k, sNj=Nj-Rank;
+        BlasMatrix<_Field> A(this->field(), sNi, sNj);
+        size_t *P2 = FFLAS::fflas_new<size_t>(sNi);
+        size_t *Q2 = FFLAS::fflas_new<size_t>(sNj);
+        size_t R2;
+
+        DensePLUQ(R2, determinant, A, P2, Q2, LigneA, Rank, k, Ni, Nj);
+
+        FFLAS::fflas_delete(P2);
+        FFLAS::fflas_delete(Q2);
+        return Rank+=R2;
+    }
+
+    template <class _Field>
+    template <class _Matrix, class Perm> inline size_t&
+    GaussDomain<_Field>::DenseLinearPivoting (size_t &Rank,
+                                              Element &determinant,
+                                              _Matrix &LigneA,
+                                              Perm &P,
+                                              size_t k,
+                                              size_t Ni,
+                                              size_t Nj) const
+    {
+        const size_t sNi=Ni-k, sNj=Nj-Rank;
+        BlasMatrix<_Field> A(this->field(), sNi, sNj);
+        size_t *P2 = FFLAS::fflas_new<size_t>(sNi);
+        size_t *Q2 = FFLAS::fflas_new<size_t>(sNj);
+        size_t R2;
+
+        DensePLUQ(R2, determinant, A, P2, Q2, LigneA, Rank, k, Ni, Nj);
+
+            // Put U2 in the active rows
+        for(size_t i=0; i<R2; ++i)
+            for(size_t j=i; j<sNj; ++j)
+                if (!this->field().isZero(A.getEntry(i,j)))
+                    LigneA[k+i].emplace_back(Rank+j,A.getEntry(i,j));
+
+            // Right-Trans: H * Q2^T
+        for (size_t j=0;j<sNj;++j)
+            if(j != Q2[j]) {
+                P.permute(Rank+j, Rank+Q2[j]);
+                for (size_t l=0; l<k; ++l)
+                    permute( LigneA[l], j+Rank+1, (long)(Q2[j]+Rank));
+            }
+
+        FFLAS::fflas_delete(P2);
+        FFLAS::fflas_delete(Q2);
+        return Rank+=R2;
+    }
+
+    template <class _Field>
+    template <class _Matrix>
+    struct GaussDomain<_Field>::DenseSwitch<_Matrix,false> {
+        bool operator()(const GaussDomain<_Field>&, size_t &,
+                        typename GaussDomain<_Field>::Element &, _Matrix &,
+                        const std::vector<size_t> &,
+                        size_t, size_t, size_t) const
+            {
+                return false;
+            }
+        template<class Perm>
+        bool operator()(const GaussDomain<_Field>&, size_t &,
+                        typename GaussDomain<_Field>::Element &, _Matrix &, Perm &,
+                        const std::vector<size_t> &,
+                        size_t, size_t, size_t) const
+            {
+                return false;
+            }
+    };
+
+    template <class _Field>
+    template <class _Matrix>
+    struct GaussDomain<_Field>::DenseSwitch<_Matrix,true> {
+        bool operator()(const GaussDomain<_Field>& GD,
+                        size_t &Rank,
+                        typename GaussDomain<_Field>::Element &determinant,
+                        _Matrix &LigneA,
+                        const std::vector<size_t> &columns,
+                        size_t k, size_t Ni, size_t Nj) const
+            {
+                if (! GD.denseSwitchReached(columns, Rank, k, Ni, Nj)) return false;
+                GD.DenseLinearPivoting(Rank, determinant, LigneA, k, Ni, Nj);
+                return true;
+            }
+        template<class Perm>
+        bool operator()(const GaussDomain<_Field>& GD,
+                        size_t &Rank,
+                        typename GaussDomain<_Field>::Element &determinant,
+                        _Matrix &LigneA,
+                        Perm &P,
+                        const std::vector<size_t> &columns,
+                        size_t k, size_t Ni, size_t Nj) const
+            {
+                if (! GD.denseSwitchReached(columns, Rank, k, Ni, Nj)) return false;
+                GD.DenseLinearPivoting(Rank, determinant, LigneA, P, k, Ni, Nj);
+                return true;
+            }
+    };
+
+
     template <class _Field>
     template <class _Matrix> inline size_t&
     GaussDomain<_Field>::InPlaceLinearPivoting (size_t &Rank,
@@ -511,8 +676,19 @@ namespace LinBox
 #else
         long sstep = 1000;
 #endif
+        // Frequency of the sparse to dense switch test
+        const long dstep = std::max(1L, (long)Nj >> 6);
+        bool densified = false;
+
         // Elimination steps with reordering
         for (long k = 0; k < last; ++k) {
+            if ( (! (k % dstep)) &&
+                 DenseSwitch<_Matrix,std::is_base_of<Givaro::FiniteRingInterface<Element>,_Field>::value>()
+                 (*this, Rank, determinant, LigneA, col_density, (size_t)k, Ni, Nj) ) {
+                densified = true;
+                break;
+            }
+
             long p = k, s = (long)LigneA[(size_t)k].size ();
 
 #ifdef __LINBOX_FILLIN__
@@ -572,7 +748,8 @@ namespace LinBox
 
         }//for k
 
-        SparseFindPivot (LigneA[(size_t)last], Rank, c, determinant);
+        if (! densified)
+            SparseFindPivot (LigneA[(size_t)last], Rank, c, determinant);
 
 #ifdef __LINBOX_COUNT__
         nbelem += LigneA[(size_t)last].size ();
@@ -652,8 +829,19 @@ namespace LinBox
 #else
         long sstep = 1000;
 #endif
+        // Frequency of the sparse to dense switch test
+        const long dstep = std::max(1L, (long)Nj >> 6);
+        bool densified = false;
+
         // Elimination steps with reordering
         for (long k = 0; k < last; ++k) {
+            if ( (! (k % dstep)) &&
+                 DenseSwitch<_Matrix,std::is_base_of<Givaro::FiniteRingInterface<Element>,_Field>::value>()
+                 (*this, Rank, determinant, LigneA, P, col_density, (size_t)k, Ni, Nj) ) {
+                densified = true;
+                break;
+            }
+
             long p = k, s =(long) LigneA[(size_t)k].size ();
 
 #ifdef __LINBOX_FILLIN__
@@ -721,8 +909,8 @@ namespace LinBox
 
         }//for k
 
-        SparseFindPivot (LigneA[(size_t)last], Rank, c, determinant);
-        if ( (c != -1) && (c != (static_cast<long>(Rank)-1) ) ) {
+        if (! densified) SparseFindPivot (LigneA[(size_t)last], Rank, c, determinant);
+        if ( (! densified) && (c != -1) && (c != (static_cast<long>(Rank)-1) ) ) {
             P.permute(Rank-1,(size_t)c);
             for (long ll=0; ll < last ; ++ll)
                 permute( LigneA[(size_t)ll], Rank, c);
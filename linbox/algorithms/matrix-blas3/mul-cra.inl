@@ -30,99 +30,58 @@
 
 #include "givaro/random-integer.h"
 #include "linbox/randiter/random-prime.h"
+#include "linbox/randiter/prime-pool.h"
 
-
-namespace LinBox { namespace BLAS3 { namespace Protected {
-
-	struct IntegerCraMatMul {
-
-
-		typedef Givaro::Modular<double>     Field;
-		typedef Field::Element      Element;
-		typedef BlasMatrix<Field>   ModularMatrix ;
-		typedef BlasMatrix<Givaro::ZRing<Integer> > IntegerMatrix ;
-
-#ifdef _LB_MM_TIMING
-#ifdef _OPENMP
-		typedef LinBox::OMPTimer Mytime;
-#else
-		typedef LinBox::Timer    Mytime;
-#endif
+#include <fflas-ffpack/field/rns-double.h>
+#ifdef __LINBOX_USE_OPENMP
+#include <omp.h>
 #endif
 
-		const IntegerMatrix &_A_, &_B_;
-
-#ifdef _LB_MM_TIMING
-		mutable Mytime chrono;
-#endif
-
-		IntegerCraMatMul(const IntegerMatrix& A, const IntegerMatrix& B) :
-			_A_(A), _B_(B)
-		{
-#ifdef _LB_MM_TIMING
-			chrono.clear();
-#endif
-			linbox_check(A.getPointer() == _A_.getPointer());
-		}
-
-		IntegerCraMatMul(IntegerMatrix& A, IntegerMatrix& B) :
-			_A_(A), _B_(B)
-		{
-#ifdef _LB_MM_TIMING
-			chrono.clear();
-#endif
-			linbox_check(A.getPointer() == _A_.getPointer());
-		}
-
-		IterationResult operator()(ModularMatrix& Cp, const Field& F) const
-		{
-			BlasMatrixDomain<Field>   BMD(F);
-
-			/*  intialisation */
-			// ModularMatrix Cpp(_A_.rowdim(),_B_.coldim());
-			// Cp = Cpp ;
-			ModularMatrix Ap(_A_, F);
-			ModularMatrix Bp(_B_, F);
-			Cp.resize(Ap.rowdim(),Bp.coldim());
 
-			/*  multiplication mod p */
+namespace LinBox { namespace BLAS3 { namespace Protected {
 
-#ifdef _LB_MM_TIMING
-			Mytime matmul; matmul.clear(); matmul.start();
-#endif
-			BMD.mul(Cp,Ap,Bp);
-			// BMD.axpyin(Cp,Ap,Bp);
-#if 0
-			// BMD.mul( static_cast<BlasMatrix<double>&>(Cp),Ap,Bp);
-			if (FAM_TYPE == _axpy)
-				BMD.axpyin(Cp,Ap,Bp);
-			else if (FAM_TYPE == _axmy)
-				BMD.axmyin(Cp,Ap,Bp);
-			else if (FAM_TYPE == _maxpy)
-				BMD.maxpyin(Cp,Ap,Bp);
-#endif
-#ifdef _LB_MM_TIMING
-			matmul.stop();
-			this->chrono+=matmul;
-#endif
-#if 0
-			if (Ap.rowdim() <= 20 && Ap.coldim() <= 20) {
-				Integer chara;
-				F.characteristic(chara);
-				F.write(cout) << endl;
-				cout << "p:=" << chara << ';' << std::endl;
-				A.write(cout<< "A:=",true) << ';' << std::endl;
-				Ap.write(cout << "Ap:=", F, true) << ';' << endl;
-				Bp.write(cout << "Bp:=", F, true) << ';' << endl;
-				Cp.write(cout<< "Cp:=", F, true) << ';' << endl;
-			}
+	/*! @internal
+	 * Integer matrix product in a residue number system.
+	 * A and B are reduced modulo all the primes of \p RNS at once, and C is
+	 * reconstructed at once: FFPACK::rns_double expresses both conversions as
+	 * word size matrix products (16 bits chunks of the entries against the
+	 * table of the \f$2^{16i} \bmod p_l\f$, residues against the CRT table).
+	 * The products modulo each prime are independent and run in parallel.
+	 * C receives the symmetric lift, so \f$M > 2\|C\|_\infty\f$ is needed.
+	 */
+	template<class IntMatrix>
+	IntMatrix & rnsMul (IntMatrix& C, const IntMatrix& A, const IntMatrix& B,
+			    const integer& mA, const integer& mB,
+			    const FFPACK::rns_double& RNS)
+	{
+		typedef Givaro::Modular<double> ModularField ;
+		const size_t m = A.rowdim(), k = A.coldim(), n = B.coldim();
+		const size_t mk = m*k, kn = k*n, mn = m*n, s = RNS._size;
+
+		double* Amod = FFLAS::fflas_new<double>(mk*s);
+		double* Bmod = FFLAS::fflas_new<double>(kn*s);
+		double* Cmod = FFLAS::fflas_new<double>(mn*s);
+		RNS.init(m, k, Amod, mk, A.getPointer(), A.getStride(), mA);
+		RNS.init(k, n, Bmod, kn, B.getPointer(), B.getStride(), mB);
+
+		const long ls((long)s);
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(dynamic) if (s > 1 && mn*k > (1<<15))
 #endif
-			return IterationResult::CONTINUE;
+		for (long l = 0; l < ls; ++l) {
+			ModularField F(RNS._basis[(size_t)l]);
+			FFLAS::fgemm(F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, m, n, k,
+				     F.one, Amod+(size_t)l*mk, k, Bmod+(size_t)l*kn, n,
+				     F.zero, Cmod+(size_t)l*mn, n);
 		}
 
+		RNS.convert(m, n, integer(0), C.getPointer(), C.getStride(), Cmod, mn);
 
-
-	};
+		FFLAS::fflas_delete(Amod);
+		FFLAS::fflas_delete(Bmod);
+		FFLAS::fflas_delete(Cmod);
+		return C;
+	}
 
 } // Protected
 } // BLAS3
@@ -135,34 +94,45 @@ namespace LinBox { namespace BLAS3 {
 			  const _anyMatrix& B,
 			  const mulMethod::CRA &)
 	{
+		linbox_check(A.coldim() == B.rowdim());
+		linbox_check(C.rowdim() == A.rowdim() && C.coldim() == B.coldim());
 
 		integer mA, mB ;
 		BlasMatrixDomain<typename _anyMatrix::Field> BMD(A.field());
 		BMD.Magnitude(mA,A);
 		BMD.Magnitude(mB,B);
-		double logC = Givaro::naturallog(mA*mB*uint64_t(A.coldim()));
 
-		typedef Givaro::Modular<double> ModularField ;
+		if (C.rowdim() == 0 || C.coldim() == 0)
+			return C;
+		if (A.coldim() == 0 || mA == 0 || mB == 0) {
+			for (size_t i = 0; i < C.rowdim(); ++i)
+				for (size_t j = 0; j < C.coldim(); ++j)
+					C.setEntry(i, j, C.field().zero);
+			return C;
+		}
 
-		{
+		// |C| <= k mA mB and the lift is symmetric
+		integer bound = mA*mB*uint64_t(A.coldim());
+		bound <<= 1;
 
-                        PrimeIterator<IteratorCategories::HeuristicTag> genprime(FieldTraits<ModularField>::bestBitSize(A.coldim()));
-			ChineseRemainder< CRABuilderFullMultipMatrix< ModularField > > cra( std::pair<size_t,double>(C.rowdim()*C.coldim(), logC) );
-			Protected::IntegerCraMatMul iteration(A,B);
+		typedef Givaro::Modular<double> ModularField ;
+		// the deterministic sequence of primes, shared by all the calls
+		PrimePool<ModularField>& primes = PrimePool<ModularField>::pool(FieldTraits<ModularField>::bestBitSize(A.coldim()));
+		std::vector<double> basis;
+		integer M(1);
+		for (size_t l = 0; M <= bound; ++l) {
+			basis.push_back((double)primes.prime(l));
+			M *= primes.prime(l);
+		}
 
-			cra(C, iteration, genprime);
+		FFPACK::rns_double RNS(basis);
+		Protected::rnsMul(C, A, B, mA, mB, RNS);
 
 #ifdef _LB_DEBUG
-#ifdef _LB_MM_TIMING
-			std::cout << "Sole modular matrix multiplications: " << iteration.chrono << std::endl;
+		Integer mC; BMD.Magnitude(mC, C);
+		std::cout << "C max: " << logtwo(mC) <<  " (" << LinBox::naturallog(mC) << ')' << " with " << basis.size() << " primes" << std::endl;
 #endif
 
-			Integer mC; BMD.Magnitude(mC, C);
-			std::cout << "C max: " << logtwo(mC) <<  " (" << LinBox::naturallog(mC) << ')' << std::endl;
-#endif
-
-		}
-
 		return C;
 
 	}
@@ -158,8 +158,7 @@ namespace LinBox
 			template<class _Rep>
 			void operator() (BlasMatrix<MultiModDouble,_Rep> &Ap, const IMatrix &A,  MatrixContainerCategory::BlasContainer type)
 			{
-				for (size_t i=0; i<Ap.field().size();++i)
-					MatrixHom::map(Ap.getMatrix(i), A);
+				Ap.copy(A);
 			}
 		};
 
@@ -169,8 +168,7 @@ namespace LinBox
 			template<class _Rep>
 			void operator() (BlasMatrix<MultiModDouble,_Rep> &Ap, const IMatrix &A,  MatrixContainerCategory::Container type)
 			{
-				for (size_t i=0; i<Ap.field().size();++i)
-					MatrixHom::map(Ap.getMatrix(i), A);
+				Ap.copy(A);
 			}
 		};
 
@@ -180,8 +178,7 @@ namespace LinBox
 			template<class _Rep>
 			void operator() (BlasMatrix<MultiModDouble,_Rep> &Ap, const IMatrix &A,  MatrixContainerCategory::Blackbox type)
 			{
-				for (size_t i=0; i<Ap.field().size();++i)
-					MatrixHom::map(Ap.getMatrix(i), A);
+				Ap.copy(A);
 			}
 		};
 #endif
@@ -4,76 +4,196 @@
 */
 
 #include <givaro/extension.h>
+#include <givaro/givpoly1.h>
 #include <linbox/algorithms/poly-interpolation.h>
 #include <linbox/solutions/det.h>
+#include <linbox/matrix/matrix-domain.h>
+#include <linbox/ring/polynomial-ring.h>
+
+// Number of evaluation points processed at once
+#if !defined(LINBOX_POLYDET_BLOCK)
+#define LINBOX_POLYDET_BLOCK 64
+#endif
 
 namespace LinBox {
-/*  
-Matrix is a polynomial matrix.  
-result is set to its determinant and returned (a polynomial).
-d is the number of evaluation points.
 
-The method is to compute dets at each evaluation point and interpolate.
- (note by bds)
+/*! @brief Determinant and rank of polynomial matrices by evaluation and
+ * interpolation.
+ *
+ * The points 0, 1, ..., d-1 are processed by blocks of b points (b and d
+ * powers of two): the matrix is evaluated at the points of a block with the
+ * subproduct tree of the block, then the b scalar matrices are factored in
+ * parallel (LU with FFLAS) and dropped.  Only b evaluated matrices are in
+ * memory at any time.  The determinant is interpolated with the subproduct
+ * tree of the d points.
+ *
+ * With early termination, the determinant is interpolated when the number
+ * K of points done is a power of two, and returned as soon as it agrees
+ * with the values at the \p earlyTerm next points (rounded up to whole
+ * blocks).  This is a heuristic when the degree of the determinant is at
+ * least K+earlyTerm, and saves the evaluations when the bound d is much
+ * larger than the degree.
  */
-template <class Field>
-typename Givaro::Poly1Dom<Field,Givaro::Dense>::Element&
-computePolyDet(typename Givaro::Poly1Dom<Field,Givaro::Dense>::Element& result,
-				DenseMatrix<Givaro::Poly1Dom<Field,Givaro::Dense> >& A, 
-               int d)
-{
-	typedef Givaro::Poly1Dom<Field,Givaro::Dense> PolyDom;
-	typedef typename PolyDom::Element PolyElt;
-	typedef typename Field::Element FieldElt;
-	//typedef MatrixDomain<Field> FieldMatDom;
-	typedef DenseMatrix<Field> FieldMat;
+template <class Field, class PolyDom = Givaro::Poly1Dom<Field,Givaro::Dense> >
+class PolyDetDomain {
+public:
+	typedef typename PolyDom::Element Polynomial;
+	typedef typename Field::Element Element;
+	typedef DenseMatrix<Field> FieldMatrix;
+	typedef PolyInterpolation<Field,PolyDom> Interpolation;
 
-	int n=A.coldim(),m=A.rowdim();
+protected:
+	Field    _F;
+	PolyDom  _PD;
+	size_t   _block;
+
+public:
+	PolyDetDomain(const Field& F, const PolyDom& PD, size_t block=LINBOX_POLYDET_BLOCK) :
+		_F(F), _PD(PD), _block(block < 2 ? 2 : block)
+	{}
 
-	PolyDom BR=A.field();
-	Field F(BR.subDomain()); // coeff field
+	const Field& field() const { return _F; }
 
-	std::vector<FieldMat> mats;
-	std::vector<FieldElt> pts(d);
-	FieldElt fieldElt;
-	F.assign(fieldElt,F.zero);
-	for (int i=0;i<d;++i) {
-		mats.push_back(FieldMat(F,m,n));
-		F.init(pts[i],int64_t(i));
+	/*! Evaluates the polynomial matrix A at the points pts, mats[k] is set
+	 * to A(pts[k]).  The number of points must be a power of two.
+	 */
+	template <class PolyMatrix>
+	void evaluate(std::vector<FieldMatrix>& mats, const PolyMatrix& A,
+	              const std::vector<Element>& pts) const
+	{
+		const size_t m=A.rowdim(), n=A.coldim(), b=pts.size();
+		const Interpolation PI(pts,_F,_PD);
+		while (mats.size()<b) mats.emplace_back(_F,m,n);
+#pragma omp parallel for shared(mats,A,PI)
+		for (size_t i=0;i<m;++i) {
+			std::vector<Element> vals;
+			for (size_t j=0;j<n;++j) {
+				PI.evaluate(vals,A.getEntry(i,j),_PD,_F);
+				for (size_t k=0;k<b;++k)
+					mats[k].setEntry(i,j,vals[k]);
+			}
+		}
 	}
 
-	commentator().report(Commentator::LEVEL_IMPORTANT,PROGRESS_REPORT)
-		<< "Initialized mats" << std::endl;
+	/*! Determinant of the square polynomial matrix A, whose degree is
+	 * less than d (a power of two, at most the cardinality of the field).
+	 * No early termination if earlyTerm is 0.
+	 */
+	template <class PolyMatrix>
+	Polynomial& det(Polynomial& result, const PolyMatrix& A, size_t d,
+	                size_t earlyTerm=0) const
+	{
+		if (A.rowdim()!=A.coldim())
+			throw LinboxError("LinBox ERROR: matrix must be square for determinant computation\n");
+		if (d<2) d=2;
+		const size_t b=blockSize(d);
+		BlasMatrixDomain<Field> BMD(_F);
+		std::vector<Element> pts(d), dets(d), blockPts(b), blockDets(b);
+		std::vector<FieldMatrix> mats;
+		for (size_t k=0;k<d;++k)
+			_F.init(pts[k],int64_t(k));
 
+		Polynomial cand;
+		bool haveCand=false;
+		size_t agreed=0;
+		for (size_t k0=0;k0<d;k0+=b) {
+			std::copy(pts.begin()+k0,pts.begin()+k0+b,blockPts.begin());
+			evaluate(mats,A,blockPts);
+#pragma omp parallel for shared(mats,blockDets,BMD)
+			for (size_t k=0;k<b;++k)
+				blockDets[k]=BMD.detInPlace(mats[k]);
 
-	PolyInterpolation<Field,PolyDom> PI(pts,F,BR);
-#pragma omp parallel for shared(mats,A,PI,BR,F)
-	for (int i=0;i<m;++i) {
-		for (int j=0;j<n;++j) {
-			PolyElt p;
-			A.getEntry(p,i,j);
-			std::vector<FieldElt> vals;
-			PI.evaluate(vals,p,BR,F);
-			for (int k=0;k<d;++k) {
-				mats[k].setEntry(i,j,vals[k]);
+			if (haveCand) {
+				bool agree=true;
+				Element v;
+				for (size_t k=0;agree && k<b;++k)
+					agree=_F.areEqual(_PD.eval(v,cand,blockPts[k]),blockDets[k]);
+				agreed=agree ? agreed+b : 0;
+				haveCand=agree;
+				if (agreed>=earlyTerm) {
+					commentator().report(Commentator::LEVEL_IMPORTANT,PROGRESS_REPORT)
+						<< "Early termination after " << k0+b << " points" << std::endl;
+					return _PD.assign(result,cand);
+				}
+			}
+			std::copy(blockDets.begin(),blockDets.end(),dets.begin()+k0);
+
+			const size_t K=k0+b;
+			if (earlyTerm && !haveCand && K<d && (K&(K-1))==0) {
+				interpolate(cand,pts,dets,K);
+				haveCand=true;
 			}
 		}
+		return interpolate(result,pts,dets,d);
 	}
 
-	commentator().report(Commentator::LEVEL_IMPORTANT,PROGRESS_REPORT)
-		<< "Finished evaluations" << std::endl;
+	/*! Rank of the polynomial matrix A, the degrees of its minors being
+	 * less than d (a power of two, at most the cardinality of the field).
+	 * Stops as soon as the rank is full.
+	 */
+	template <class PolyMatrix>
+	size_t rank(const PolyMatrix& A, size_t d) const
+	{
+		const size_t full=std::min(A.rowdim(),A.coldim());
+		if (d<2) d=2;
+		const size_t b=blockSize(d);
+		BlasMatrixDomain<Field> BMD(_F);
+		std::vector<Element> blockPts(b);
+		std::vector<size_t> ranks(b);
+		std::vector<FieldMatrix> mats;
+		size_t r=0;
+		for (size_t k0=0;k0<d && r<full;k0+=b) {
+			for (size_t k=0;k<b;++k)
+				_F.init(blockPts[k],int64_t(k0+k));
+			evaluate(mats,A,blockPts);
+#pragma omp parallel for shared(mats,ranks,BMD)
+			for (size_t k=0;k<b;++k)
+				ranks[k]=BMD.rankInPlace(mats[k]);
+			r=std::max(r,*std::max_element(ranks.begin(),ranks.end()));
+		}
+		return r;
+	}
 
-	std::vector<FieldElt> dets(d);
-#pragma omp parallel for shared(dets,mats)
-	for (int k=0;k<d;++k) {
-		det(dets[k],mats[k],Method::Elimination());
+protected:
+	size_t blockSize(size_t d) const
+	{
+		size_t b=2;
+		while (2*b<=_block && 2*b<=d) b<<=1;
+		return b;
 	}
 
-	PI.interpolate(result,pts,dets,BR,F);
-	return result;
+	// interpolates the K first values
+	Polynomial& interpolate(Polynomial& result, const std::vector<Element>& pts,
+	                        const std::vector<Element>& vals, size_t K) const
+	{
+		const std::vector<Element> p(pts.begin(),pts.begin()+K), v(vals.begin(),vals.begin()+K);
+		const Interpolation PI(p,_F,_PD);
+		return PI.interpolate(result,p,v,_PD,_F);
+	}
+};
+
+/*
+Matrix is a polynomial matrix.
+result is set to its determinant and returned (a polynomial).
+d is the number of evaluation points.
+
+The method is to compute dets at each evaluation point and interpolate.
+ (note by bds)
+ */
+template <class Field>
+typename Givaro::Poly1Dom<Field,Givaro::Dense>::Element&
+computePolyDet(typename Givaro::Poly1Dom<Field,Givaro::Dense>::Element& result,
+				DenseMatrix<Givaro::Poly1Dom<Field,Givaro::Dense> >& A,
+               int d, size_t earlyTerm=0)
+{
+	typedef Givaro::Poly1Dom<Field,Givaro::Dense> PolyDom;
+
+	const PolyDom& BR=A.field();
+	PolyDetDomain<Field,PolyDom> PDD(BR.subdomain(),BR);
+	return PDD.det(result,A,d,earlyTerm);
 }
 
-int roundUpPowerOfTwo(unsigned int n)
+inline int roundUpPowerOfTwo(unsigned int n)
 {
 	if (n==0) {
 		return 0;
@@ -190,6 +310,61 @@ computePolyDetExtension(typename Givaro::Poly1Dom<Field,Givaro::Dense>::Element&
 	return result;
 }
 
+/*! Determinant of a square matrix over K[x], by evaluation and
+ * interpolation over K (see PolyDetDomain).  The degree bound is the sum of
+ * the row degrees, K must have more elements than this bound; over smaller
+ * fields, see computePolyDetExtension.  Early termination is done after
+ * \c Meth.earlyTerminationThreshold successful points, 0 to disable it.
+ * The points being 0,1,2,..., early termination is a heuristic that
+ * structured matrices can defeat (e.g. diag(x, x-1, ...)): it must be
+ * asked for explicitly, the overload without method does not use it.
+ */
+template <class Field, class MyMethod>
+typename PolynomialRing<Field,Givaro::Dense>::Element&
+det(typename PolynomialRing<Field,Givaro::Dense>::Element& d,
+    const DenseMatrix<PolynomialRing<Field,Givaro::Dense> >& A,
+    const MyMethod& Meth)
+{
+	typedef PolynomialRing<Field,Givaro::Dense> Ring;
+	typedef typename Ring::Parent_t PolyDom;
+
+	if (A.rowdim()!=A.coldim())
+		throw LinboxError("LinBox ERROR: matrix must be square for determinant computation\n");
+
+	const Ring& R=A.field();
+	size_t bound=0;
+	for (size_t i=0;i<A.rowdim();++i) {
+		size_t rowMaxD=0;
+		for (size_t j=0;j<A.coldim();++j)
+			if (!R.isZero(A.getEntry(i,j)))
+				rowMaxD=std::max(rowMaxD,(size_t)R.degree(A.getEntry(i,j)).value());
+		bound += rowMaxD;
+	}
+	const size_t npts=roundUpPowerOfTwo(bound+1);
+
+	integer card;
+	R.subdomain().cardinality(card);
+	if (card<integer((uint64_t)npts))
+		throw LinboxError("LinBox ERROR: coefficient field too small for the polynomial determinant\n");
+
+	commentator().start ("Polynomial Determinant", "pdet");
+	PolyDetDomain<Field,PolyDom> PDD(R.subdomain(),R);
+	typename PolyDom::Element p;
+	PDD.det(p,A,npts,Meth.earlyTerminationThreshold);
+	commentator().stop ("done", NULL, "pdet");
+	return R.assign(d,p);
+}
+
+template <class Field>
+typename PolynomialRing<Field,Givaro::Dense>::Element&
+det(typename PolynomialRing<Field,Givaro::Dense>::Element& d,
+    const DenseMatrix<PolynomialRing<Field,Givaro::Dense> >& A)
+{
+	Method::Auto Meth;
+	Meth.earlyTerminationThreshold=0;
+	return det(d,A,Meth);
+}
+
 }
 
 #endif //__LINBOX_POLY_DET_H
@@ -13,14 +13,14 @@ namespace LinBox {
 template<class Field, class PolyDom>
 class PolyInterpolation {
 public:
-	typedef GivaroPoly<PolyDom> Ring;
+	typedef PolyDom Ring;
 	typedef typename Ring::Element RingElt;
 	typedef typename Field::Element FieldElt;
 	typedef std::vector<std::vector<RingElt> > ProductTree;
 
 	PolyInterpolation(const std::vector<FieldElt>& pts,
-	                  Field& F,
-	                  PolyDom& PD)
+	                  const Field& F,
+	                  const PolyDom& PD)
 	{
 		int n=pts.size();
 
@@ -49,8 +49,8 @@ public:
 	RingElt& interpolate(RingElt& poly,
 	                     const std::vector<FieldElt>& pts,
 	                     const std::vector<FieldElt>& vals,
-	                     PolyDom& PD,
-	                     Field& F)
+	                     const PolyDom& PD,
+	                     const Field& F) const
 	{
 		int n=pts.size();
 		std::vector<FieldElt> si;
@@ -67,7 +67,7 @@ public:
 
 	RingElt& scaledSum(RingElt& comb,
 	                   const std::vector<FieldElt>& cs,
-	                   PolyDom& PD)
+	                   const PolyDom& PD) const
 	{
 		int numPts=cs.size();
 		std::vector<RingElt> fRow,tempRow;
@@ -95,8 +95,8 @@ public:
 
 	void evaluate(std::vector<FieldElt>& vals,
 	              const RingElt& poly,
-	              PolyDom& PD,
-	              Field& F)
+	              const PolyDom& PD,
+	              const Field& F) const
 	{
 		std::vector<RingElt> fRow,tempRow;
 		fRow.push_back(poly);
@@ -128,14 +128,10 @@ public:
 	static void naiveInterpolate(RingElt& poly,
 	                             const std::vector<FieldElt>& vals,
 	                             const std::vector<FieldElt>& pts,
-	                             GivaroPoly<PolyDom>& R,
+	                             PolyDom& R,
 	                             PolyDom& PD,
 	                             Field& F)
 	{
-		typedef GivaroPoly<PolyDom> Ring;
-		typedef typename Ring::Element RingElt;
-		typedef typename Ring::Scalar_t FieldElt;
-
 		int n=vals.size();
 		linbox_check(vals.size()==pts.size());
 		PD.assign(poly,PD.zero);
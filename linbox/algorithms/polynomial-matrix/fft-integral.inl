@@ -1818,6 +1818,14 @@ namespace LinBox {
              */
 
             /* DIF ************************************************************/
+            /* The stages are done two at a time (radix 4), so that each pass
+             * on the array reads and writes every coefficient only once. For
+             * a block of 4*h rows (h = w/2) and j < h, the rows j, j+h, j+2h
+             * and j+3h go through the butterflies of width w (roots pow[j]
+             * and pow[j+h]) then of width h (root pow[w+j]).
+             * If the number of stages is odd, the last one (w = 1) is done
+             * alone.
+             */
             /* Simd */
             template<size_t VecSize>
             void
@@ -1827,40 +1835,98 @@ namespace LinBox {
                 simd_vect_t P = Simd::set1 (fld->characteristic());
                 simd_vect_t P2 = Simd::set1 (fld->characteristic() << 1);
 
-                for ( ; w > 0; pow += w, powp += w, f <<= 1, w >>= 1) {
-                    size_t ws = w*stride;
-                    Element *Aptr = coeffs;
-                    Element *Bptr = coeffs + ws;
-                    for (size_t i = 0; i < f; i++, Aptr += ws, Bptr += ws)
-                        for (size_t j = 0; j < w; j += 1) {
+                for ( ; w > 1; pow += w + (w >> 1), powp += w + (w >> 1),
+                                                        f <<= 2, w >>= 2) {
+                    size_t hs = (w >> 1) * stride;
+                    const Element *pow2 = pow + w, *powp2 = powp + w;
+                    for (size_t i = 0; i < f; i++)
+                        for (size_t j = 0; j < (w >> 1); j++) {
+                            Element *Aptr = coeffs + (2*i*w + j) * stride;
                             simd_vect_t alpha = Simd::set1 (pow[j]);
                             simd_vect_t alphap = Simd::set1 (powp[j]);
+                            simd_vect_t beta = Simd::set1 (pow[j + (w >> 1)]);
+                            simd_vect_t betap = Simd::set1 (powp[j + (w >> 1)]);
+                            simd_vect_t gamma = Simd::set1 (pow2[j]);
+                            simd_vect_t gammap = Simd::set1 (powp2[j]);
                             size_t l = 0;
                             for ( ; l + Simd::vect_size <= stride;
                                                         l += Simd::vect_size,
-                                                        Aptr += Simd::vect_size,
-                                                        Bptr += Simd::vect_size)
-                                Butterfly_DIF (Aptr, Bptr, alpha, alphap, P,P2);
-                            for ( ; l < stride; l++, Aptr++, Bptr++)
-                                Butterfly_DIF (*Aptr, *Bptr, pow[j],powp[j],p2);
+                                                        Aptr += Simd::vect_size) {
+                                simd_vect_t V0 = Simd::loadu (Aptr);
+                                simd_vect_t V1 = Simd::loadu (Aptr + hs);
+                                simd_vect_t V2 = Simd::loadu (Aptr + 2*hs);
+                                simd_vect_t V3 = Simd::loadu (Aptr + 3*hs);
+                                Butterfly_DIF (V0, V2, alpha, alphap, P, P2);
+                                Butterfly_DIF (V1, V3, beta, betap, P, P2);
+                                Butterfly_DIF (V0, V1, gamma, gammap, P, P2);
+                                Butterfly_DIF (V2, V3, gamma, gammap, P, P2);
+                                Simd::storeu (Aptr, V0);
+                                Simd::storeu (Aptr + hs, V1);
+                                Simd::storeu (Aptr + 2*hs, V2);
+                                Simd::storeu (Aptr + 3*hs, V3);
+                            }
+                            for ( ; l < stride; l++, Aptr++)
+                                Butterfly_DIF_radix4 (Aptr, hs, j, w >> 1,
+                                                        pow, powp, pow2, powp2);
                         }
                 }
+                if (w == 1)
+                    DIF_last_stage (coeffs, f, stride, pow, powp, h);
             }
 
             /* NoSimd */
             void
             DIF_core (Element *coeffs, size_t w, size_t f, size_t stride,
                                         const Element *pow, const Element *powp,
-                                        FFTSimdHelper<1>) const {
-                for ( ; w > 0; pow += w, powp += w, f <<= 1, w >>= 1) {
-                    size_t ws = w*stride;
-                    Element *Aptr = coeffs;
-                    Element *Bptr = coeffs + ws;
-                    for (size_t i = 0; i < f; i++, Aptr += ws, Bptr += ws)
-                        for (size_t j = 0; j < w; j += 1)
-                            for (size_t l = 0; l < stride; l++, Aptr++, Bptr++)
-                                Butterfly_DIF (*Aptr, *Bptr, pow[j],powp[j],p2);
+                                        FFTSimdHelper<1> h) const {
+                for ( ; w > 1; pow += w + (w >> 1), powp += w + (w >> 1),
+                                                        f <<= 2, w >>= 2) {
+                    size_t hs = (w >> 1) * stride;
+                    const Element *pow2 = pow + w, *powp2 = powp + w;
+                    for (size_t i = 0; i < f; i++)
+                        for (size_t j = 0; j < (w >> 1); j++) {
+                            Element *Aptr = coeffs + (2*i*w + j) * stride;
+                            for (size_t l = 0; l < stride; l++, Aptr++)
+                                Butterfly_DIF_radix4 (Aptr, hs, j, w >> 1,
+                                                        pow, powp, pow2, powp2);
+                        }
                 }
+                if (w == 1)
+                    DIF_last_stage (coeffs, f, stride, pow, powp, h);
+            }
+
+            /* Butterflies of width 1, with root pow[0] = 1 */
+            template<size_t VecSize>
+            void
+            DIF_last_stage (Element *coeffs, size_t f, size_t stride,
+                                        const Element *pow, const Element *powp,
+                                        FFTSimdHelper<VecSize>) const {
+                simd_vect_t P = Simd::set1 (fld->characteristic());
+                simd_vect_t P2 = Simd::set1 (fld->characteristic() << 1);
+                simd_vect_t alpha = Simd::set1 (pow[0]);
+                simd_vect_t alphap = Simd::set1 (powp[0]);
+                Element *Aptr = coeffs;
+                Element *Bptr = coeffs + stride;
+                for (size_t i = 0; i < f; i++, Aptr += stride, Bptr += stride) {
+                    size_t l = 0;
+                    for ( ; l + Simd::vect_size <= stride; l += Simd::vect_size,
+                                                        Aptr += Simd::vect_size,
+                                                        Bptr += Simd::vect_size)
+                        Butterfly_DIF (Aptr, Bptr, alpha, alphap, P, P2);
+                    for ( ; l < stride; l++, Aptr++, Bptr++)
+                        Butterfly_DIF (*Aptr, *Bptr, pow[0], powp[0], p2);
+                }
+            }
+
+            void
+            DIF_last_stage (Element *coeffs, size_t f, size_t stride,
+                                        const Element *pow, const Element *powp,
+                                        FFTSimdHelper<1>) const {
+                Element *Aptr = coeffs;
+                Element *Bptr = coeffs + stride;
+                for (size_t i = 0; i < f; i++, Aptr += stride, Bptr += stride)
+                    for (size_t l = 0; l < stride; l++, Aptr++, Bptr++)
+                        Butterfly_DIF (*Aptr, *Bptr, pow[0], powp[0], p2);
             }
 
             /* DIT reversed ***************************************************/
@@ -1912,6 +1978,12 @@ namespace LinBox {
             }
 
             /* DIT ************************************************************/
+            /* Same as DIF_core in the reverse order: for a block of 4*w rows
+             * and j < w, the rows j, j+w, j+2w and j+3w go through the
+             * butterflies of width w (root pow[j]) then of width 2w (roots
+             * pow[j-2w] and pow[j-w]). If the number of stages is odd, the
+             * last one (w = n/2) is done alone.
+             */
             /* Simd */
             template<size_t VecSize>
             void
@@ -1921,42 +1993,98 @@ namespace LinBox {
                 simd_vect_t P = Simd::set1 (fld->characteristic());
                 simd_vect_t P2 = Simd::set1 (fld->characteristic() << 1);
 
-                for ( ; w < n; w <<= 1, f >>= 1, pow -= w, powp -= w) {
+                for ( ; 2*w < n; pow -= 6*w, powp -= 6*w, w <<= 2, f >>= 2) {
                     size_t ws = w*stride;
-                    Element *Aptr = coeffs;
-                    Element *Bptr = coeffs + ws;
-                    for (size_t i = 0; i < f; i++, Aptr += ws, Bptr += ws)
-                        for (size_t j = 0; j < w; j += 1) {
+                    const Element *pow2 = pow - 2*w, *powp2 = powp - 2*w;
+                    for (size_t i = 0; i < (f >> 1); i++)
+                        for (size_t j = 0; j < w; j++) {
+                            Element *Aptr = coeffs + (4*i*w + j) * stride;
                             simd_vect_t alpha = Simd::set1 (pow[j]);
                             simd_vect_t alphap = Simd::set1 (powp[j]);
+                            simd_vect_t beta = Simd::set1 (pow2[j]);
+                            simd_vect_t betap = Simd::set1 (powp2[j]);
+                            simd_vect_t gamma = Simd::set1 (pow2[j + w]);
+                            simd_vect_t gammap = Simd::set1 (powp2[j + w]);
                             size_t l = 0;
                             for ( ; l + Simd::vect_size <= stride;
                                                         l += Simd::vect_size,
-                                                        Aptr += Simd::vect_size,
-                                                        Bptr += Simd::vect_size)
-                                Butterfly_DIT (Aptr, Bptr, alpha, alphap, P,P2);
-                            for ( ; l < stride; l++, Aptr++, Bptr++)
-                                Butterfly_DIT (*Aptr, *Bptr, pow[j],powp[j],p2);
+                                                        Aptr += Simd::vect_size) {
+                                simd_vect_t V0 = Simd::loadu (Aptr);
+                                simd_vect_t V1 = Simd::loadu (Aptr + ws);
+                                simd_vect_t V2 = Simd::loadu (Aptr + 2*ws);
+                                simd_vect_t V3 = Simd::loadu (Aptr + 3*ws);
+                                Butterfly_DIT (V0, V1, alpha, alphap, P, P2);
+                                Butterfly_DIT (V2, V3, alpha, alphap, P, P2);
+                                Butterfly_DIT (V0, V2, beta, betap, P, P2);
+                                Butterfly_DIT (V1, V3, gamma, gammap, P, P2);
+                                Simd::storeu (Aptr, V0);
+                                Simd::storeu (Aptr + ws, V1);
+                                Simd::storeu (Aptr + 2*ws, V2);
+                                Simd::storeu (Aptr + 3*ws, V3);
+                            }
+                            for ( ; l < stride; l++, Aptr++)
+                                Butterfly_DIT_radix4 (Aptr, ws, j, w,
+                                                        pow, powp, pow2, powp2);
                         }
                 }
+                if (w < n)
+                    DIT_last_stage (coeffs, w, stride, pow, powp, h);
             }
 
             /* NoSimd */
             void
             DIT_core (Element *coeffs, size_t w, size_t f, size_t stride,
                                         const Element *pow, const Element *powp,
-                                        FFTSimdHelper<1>) const {
-                for ( ; w < n; w <<= 1, f >>= 1, pow -= w, powp -= w) {
+                                        FFTSimdHelper<1> h) const {
+                for ( ; 2*w < n; pow -= 6*w, powp -= 6*w, w <<= 2, f >>= 2) {
                     size_t ws = w*stride;
-                    Element *Aptr = coeffs;
-                    Element *Bptr = coeffs + ws;
-                    for (size_t i = 0; i < f; i++, Aptr += ws, Bptr += ws)
-                        for (size_t j = 0; j < w; j += 1)
-                            for (size_t l = 0; l < stride; l++, Aptr++, Bptr++)
-                                Butterfly_DIT (*Aptr, *Bptr, pow[j],powp[j],p2);
+                    const Element *pow2 = pow - 2*w, *powp2 = powp - 2*w;
+                    for (size_t i = 0; i < (f >> 1); i++)
+                        for (size_t j = 0; j < w; j++) {
+                            Element *Aptr = coeffs + (4*i*w + j) * stride;
+                            for (size_t l = 0; l < stride; l++, Aptr++)
+                                Butterfly_DIT_radix4 (Aptr, ws, j, w,
+                                                        pow, powp, pow2, powp2);
+                        }
+                }
+                if (w < n)
+                    DIT_last_stage (coeffs, w, stride, pow, powp, h);
+            }
+
+            /* Butterflies of width w = n/2, a single family */
+            template<size_t VecSize>
+            void
+            DIT_last_stage (Element *coeffs, size_t w, size_t stride,
+                                        const Element *pow, const Element *powp,
+                                        FFTSimdHelper<VecSize>) const {
+                simd_vect_t P = Simd::set1 (fld->characteristic());
+                simd_vect_t P2 = Simd::set1 (fld->characteristic() << 1);
+                Element *Aptr = coeffs;
+                Element *Bptr = coeffs + w*stride;
+                for (size_t j = 0; j < w; j++) {
+                    simd_vect_t alpha = Simd::set1 (pow[j]);
+                    simd_vect_t alphap = Simd::set1 (powp[j]);
+                    size_t l = 0;
+                    for ( ; l + Simd::vect_size <= stride; l += Simd::vect_size,
+                                                        Aptr += Simd::vect_size,
+                                                        Bptr += Simd::vect_size)
+                        Butterfly_DIT (Aptr, Bptr, alpha, alphap, P, P2);
+                    for ( ; l < stride; l++, Aptr++, Bptr++)
+                        Butterfly_DIT (*Aptr, *Bptr, pow[j], powp[j], p2);
                 }
             }
 
+            void
+            DIT_last_stage (Element *coeffs, size_t w, size_t stride,
+                                        const Element *pow, const Element *powp,
+                                        FFTSimdHelper<1>) const {
+                Element *Aptr = coeffs;
+                Element *Bptr = coeffs + w*stride;
+                for (size_t j = 0; j < w; j++)
+                    for (size_t l = 0; l < stride; l++, Aptr++, Bptr++)
+                        Butterfly_DIT (*Aptr, *Bptr, pow[j], powp[j], p2);
+            }
+
             /* DIF reversed ***************************************************/
             /* Simd */
             template<size_t VecSize>
@@ -2031,6 +2159,38 @@ namespace LinBox {
                 this->fld->mul_precomp_b_without_reduction (B, B, alpha, alphap);
             }
 
+            /* Same as above, on registers */
+            void
+            Butterfly_DIF (simd_vect_t& A, simd_vect_t& B,
+                            const simd_vect_t& alpha, const simd_vect_t& alphap,
+                            const simd_vect_t& P, const simd_vect_t& P2) const {
+                simd_vect_t T1, T2, T3;
+
+                /* A+B mod 2p */
+                T1 = SimdExtra::add_mod (A, B, P2);
+                /* A-B mod 2p (computed as A+(2p-B)) */
+                T2 = Simd::sub (P2, B);
+                T3 = Simd::add (A, T2);
+                /* multiply A-B by alpha */
+                B = SimdExtra::mul_mod (T3, alpha, P, alphap);
+
+                A = T1;
+            }
+
+            /* The two stages of DIF_core on the rows 0, hs, 2*hs and 3*hs of
+             * Aptr, for the index j of a block of 4*h rows.
+             */
+            void
+            Butterfly_DIF_radix4 (Element *Aptr, size_t hs, size_t j, size_t h,
+                                    const Element *pow, const Element *powp,
+                                    const Element *pow2,
+                                    const Element *powp2) const {
+                Butterfly_DIF (Aptr[0], Aptr[2*hs], pow[j], powp[j], p2);
+                Butterfly_DIF (Aptr[hs], Aptr[3*hs], pow[j+h], powp[j+h], p2);
+                Butterfly_DIF (Aptr[0], Aptr[hs], pow2[j], powp2[j], p2);
+                Butterfly_DIF (Aptr[2*hs], Aptr[3*hs], pow2[j], powp2[j], p2);
+            }
+
             void
             Butterfly_DIF (Element *Aptr, Element *Bptr,
                             const simd_vect_t& alpha, const simd_vect_t& alphap,
@@ -2073,6 +2233,37 @@ namespace LinBox {
                 A += tmp;
             }
 
+            /* Same as above, on registers */
+            void
+            Butterfly_DIT (simd_vect_t& A, simd_vect_t& B,
+                            const simd_vect_t& alpha, const simd_vect_t& alphap,
+                            const simd_vect_t& P, const simd_vect_t& P2) const {
+                simd_vect_t T1, T2, T3;
+
+                T1 = SimdExtra::reduce (A, P2); /* A - 2*p if A >= 2p */
+                /* B*alpha */
+                T2 = SimdExtra::mul_mod (B, alpha, P, alphap);
+                /* A+B*alpha */
+                A = Simd::add (T1, T2);
+                /* A-B*alpha (computed as A+(2p-B*alpha)) */
+                T3 = Simd::sub (P2, T2);
+                B = Simd::add (T1, T3);
+            }
+
+            /* The two stages of DIT_core on the rows 0, ws, 2*ws and 3*ws of
+             * Aptr, for the index j of a block of 4*w rows.
+             */
+            void
+            Butterfly_DIT_radix4 (Element *Aptr, size_t ws, size_t j, size_t w,
+                                    const Element *pow, const Element *powp,
+                                    const Element *pow2,
+                                    const Element *powp2) const {
+                Butterfly_DIT (Aptr[0], Aptr[ws], pow[j], powp[j], p2);
+                Butterfly_DIT (Aptr[2*ws], Aptr[3*ws], pow[j], powp[j], p2);
+                Butterfly_DIT (Aptr[0], Aptr[2*ws], pow2[j], powp2[j], p2);
+                Butterfly_DIT (Aptr[ws], Aptr[3*ws], pow2[j+w], powp2[j+w], p2);
+            }
+
             void
             Butterfly_DIT (Element *Aptr, Element *Bptr,
                             const simd_vect_t& alpha, const simd_vect_t& alphap,
@@ -148,6 +148,11 @@ namespace LinBox {
     /**************************************************************************/
     /**************************************************************************/
     /**************************************************************************/
+    /* Batched FFT: the 'stride' polynomials of size n are interleaved, the
+     * coefficient k of the l-th polynomial being coeffs[k*stride+l], so that
+     * each lane of the Simd vectors handles a different polynomial. With
+     * AVX-512, Simd<Element> holds 16 32-bit or 8 64-bit elements.
+     */
     template <typename Field, typename Simd= Simd<typename Field::Element> >
     class FFT_multi : public FFT_multi_base<Field, Simd>
     {
@@ -163,7 +168,8 @@ namespace LinBox {
             /* main functions: FFT_direct and FFT_inverse *********************/
             /******************************************************************/
 
-            /* Perform a FFT in place on the array 'coeffs' of size n.
+            /* Perform a FFT in place on the 'stride' polynomials of the array
+             * 'coeffs' of size n*stride.
              * Input:
              *  - must be < p
              *  - is read in natural order
@@ -176,7 +182,8 @@ namespace LinBox {
                 this->DIF (coeffs, stride); /* or DIT_reversed */
             }
 
-            /* Perform an inverse FFT in place on the array 'coeffs' of size n.
+            /* Perform an inverse FFT in place on the 'stride' polynomials of
+             * the array 'coeffs' of size n*stride.
              * Input:
              *  - must be < p
              *  - is read in bitreversed order.
@@ -31,6 +31,14 @@
 #include "linbox/matrix/polynomial-matrix.h"
 #include "linbox/matrix/matrix-domain.h"
 #include "linbox/algorithms/polynomial-matrix/fft.h"
+#ifdef __LINBOX_USE_OPENMP
+#include <omp.h>
+#endif
+
+// Size in bytes of the buffers holding a group of points for the pointwise products
+#if !defined(LINBOX_FFT_POINTWISE_CACHE)
+#define LINBOX_FFT_POINTWISE_CACHE 262144
+#endif
 
 namespace LinBox {
 
@@ -52,6 +60,69 @@ namespace LinBox {
 		uint64_t                      _p;
 		BlasMatrixDomain<Field>     _BMD;
 
+		typedef typename Field::Element Element;
+
+		// forward FFTs of all the entries of a, distributed over the threads
+		void FFT_direct_all (const FFT<Field>& FFTer, MatrixP &a) const {
+			const long N = (long)(a.rowdim()*a.coldim());
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(static) if (N > 1)
+#endif
+			for (long i = 0; i < N; i++)
+				FFTer.FFT_direct(&(a.ref((size_t)i,0)));
+		}
+
+		// inverse FFTs of all the entries of c, followed by the division by the number of points
+		void FFT_inverse_all (const FFT<Field>& FFTinv, MatrixP &c) const {
+			const size_t pts = c.size();
+			Element inv_pts;
+			field().init(inv_pts, pts);
+			field().invin(inv_pts);
+			const long N = (long)(c.rowdim()*c.coldim());
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(static) if (N > 1)
+#endif
+			for (long i = 0; i < N; i++) {
+				Element* ci = &(c.ref((size_t)i,0));
+				FFTinv.FFT_inverse(ci);
+				FFLAS::fscalin(field(), pts, inv_pts, ci, 1);
+			}
+		}
+
+		/* c(w^j) = a(w^j) b(w^j) for all the points, evaluation point major:
+		 * the points are split in groups whose m x k, k x n and m x n
+		 * matrices fit in LINBOX_FFT_POINTWISE_CACHE bytes; each thread
+		 * transposes its group of points from polfirst to matfirst in its own
+		 * buffers, does one fgemm per point and transposes the products back.
+		 */
+		void pointwise (MatrixP &c, const MatrixP &a, const MatrixP &b) const {
+			const size_t m = a.rowdim(), k = a.coldim(), n = b.coldim(), pts = c.size();
+			const size_t mk = m*k, kn = k*n, mn = m*n;
+			if (mn == 0) return;
+			const size_t point_size = (mk+kn+mn)*sizeof(Element);
+			const size_t G = std::max((size_t)1, std::min(pts, (size_t)LINBOX_FFT_POINTWISE_CACHE/point_size));
+			const long ngroups = (long)((pts+G-1)/G);
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel if (ngroups > 1)
+#endif
+			{
+				std::vector<Element> buf((mk+kn+mn)*G);
+				Element *A = buf.data(), *B = A+mk*G, *C = B+kn*G;
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+				for (long g = 0; g < ngroups; g++) {
+					const size_t p0 = (size_t)g*G, np = std::min(G, pts-p0);
+					Protected::transpose_co(A, mk, a.getPointer()+p0, pts, mk, np);
+					Protected::transpose_co(B, kn, b.getPointer()+p0, pts, kn, np);
+					for (size_t j = 0; j < np; j++)
+						FFLAS::fgemm(field(), FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, m, n, k,
+							     field().one, A+j*mk, k, B+j*kn, n, field().zero, C+j*mn, n);
+					Protected::transpose_co(c.getPointer()+p0, pts, C, mn, np, mn);
+				}
+			}
+		}
+
 	public:
 		inline const Field & field() const { return *_field; }
 
@@ -85,9 +156,6 @@ namespace LinBox {
 		// -> use TFT to circumvent the padding issue
 		void mul_fft (size_t lpts, MatrixP &c, MatrixP &a, MatrixP &b) const {
 			FFT_PROFILE_START(1);
-			size_t m = a.rowdim();
-			size_t k = a.coldim();
-			size_t n = b.coldim();
 			size_t pts=c.size();
 			//std::cout<<"mul : 2^"<<lpts<<std::endl;
 
@@ -122,76 +190,17 @@ namespace LinBox {
 			// std::cout<<b<<std::endl;
 			
 			// FFT transformation on the input matrices
-			for (size_t i = 0; i < m * k; i++)
-				FFTer.FFT_direct(&(a.ref(i,0)));
-			for (size_t i = 0; i < k * n; i++)
-				FFTer.FFT_direct(&(b.ref(i,0)));
+			FFT_direct_all(FFTer, a);
+			FFT_direct_all(FFTer, b);
 			FFT_PROFILING(1,"direct FFT_DIF");
-			
-			// std::cout<<"DIF:  w="<<FFTer._w<<std::endl;
-			// std::cout<<a<<std::endl;
-			// std::cout<<b<<std::endl;
-			
-			
-			// convert the matrix representation to matfirst (with double coefficient)
-			PMatrix vm_c (field(), m, n, pts);
-#ifdef TRY1
-			BlasMatrix<Field> vm_a(field(),m,k);
-			BlasMatrix<Field> vm_b(field(),k,n);
-			FFT_PROFILING(1,"creation of Matfirst");
-
-			// Pointwise multiplication
-			for (size_t i = 0; i < pts; ++i){
-				a.setMatrix(vm_a,i);
-				b.setMatrix(vm_b,i);
-				_BMD.mul(vm_c[i], vm_a, vm_b);
-			}
-			FFT_PROFILING(1,"Pointwise mult");
-			
-#else
-			PMatrix vm_a (field(), m, k, pts);
-			PMatrix vm_b (field(), k, n, pts);
-			FFT_PROFILING(1,"creation of Matfirst");
-			vm_a.copy(a);
-			vm_b.copy(b);
-			FFT_PROFILING(1,"Polfirst to Matfirst");
 
 			// Pointwise multiplication
-			for (size_t i = 0; i < pts; ++i){
-                auto vm_c_i = vm_c[i];
-				_BMD.mul(vm_c_i, vm_a[i], vm_b[i]);
-                vm_c.setMatrix(vm_c_i,i); // normally does nothing
-            }
+			pointwise(c, a, b);
 			FFT_PROFILING(1,"Pointwise mult");
-#endif			
-			// Transformation into matrix of polynomials (with int32_t coefficient)
-			c.copy(vm_c);
-			FFT_PROFILING(1,"Matfirst to Polfirst");
 
-			//std::cout<<"pointwise:"<<std::endl;
-			//std::cout<<c<<std::endl;			
-			
-			// Inverse FFT on the output matrix
-			for (size_t i = 0; i < m * n; i++)
-				FFTinv.FFT_inverse(&(c.ref(i,0)));
+			// Inverse FFT on the output matrix and division by pts = 2^lpts
+			FFT_inverse_all(FFTinv, c);
 			FFT_PROFILING(1,"inverse FFT_DIT");
-
-			// std::cout<<"DIT:"<<std::endl;
-			// std::cout<<c<<std::endl;
-
-			// Divide by pts = 2^lpts
-			typename Field::Element inv_pts;
-			field().init(inv_pts, pts);
-			field().invin(inv_pts);
-			// for (size_t i = 0; i < m * n; i++) 
-			// 	for (size_t j = 0; j < pts; j++)
-			// 		field().mulin(c.ref(i,j), inv_pts);
-			FFLAS::fscalin(field(),c.rowdim()*c.coldim()*c.size(), inv_pts,  c.getPointer(),1);
-
-			// std::cout<<"SCALIN:"<<std::endl;
-			// std::cout<<c<<std::endl;
-
-			FFT_PROFILING(1,"scaling the result");
 #ifdef FFT_PROFILER
 			totalTime.stop();
 			//std::cout<<"FFT(1): total time : "<<totalTime<<std::endl;
@@ -246,9 +255,6 @@ namespace LinBox {
 		void midproduct_fft (size_t lpts, MatrixP &c, MatrixP &a, MatrixP &b,
 				     bool smallLeft=true) const {
 			FFT_PROFILE_START(1);
-			size_t m = a.rowdim();
-			size_t k = a.coldim();
-			size_t n = b.coldim();
 			size_t pts=c.size();
 			//cout<<"mid : "<<pts<<endl;
 #ifdef FFT_PROFILER
@@ -265,55 +271,17 @@ namespace LinBox {
 			FFT_PROFILING(1,"init");
 
 			// FFT transformation on the input matrices
-			if (smallLeft){
-				for (size_t i = 0; i < m * k; i++)
-					FFTer.FFT_direct(&(a(i)[0]));
-				for (size_t i = 0; i < k * n; i++)
-					FFTinv.FFT_direct(&(b(i)[0]));
-			}
-			else {
-				for (size_t i = 0; i < m * k; i++)
-					FFTinv.FFT_direct(&(a(i)[0]));
-				for (size_t i = 0; i < k * n; i++)
-					FFTer.FFT_direct(&(b(i)[0]));
-			}
+			FFT_direct_all(smallLeft ? FFTer : FFTinv, a);
+			FFT_direct_all(smallLeft ? FFTinv : FFTer, b);
 			FFT_PROFILING(1,"direct FFT_DIF");
 
-			// convert the matrix representation to matfirst (with double coefficient)
-			PMatrix vm_c (field(), m, n, pts);
-			PMatrix vm_a (field(), m, k, pts);
-			PMatrix vm_b (field(), k, n, pts);
-			FFT_PROFILING(1,"creation of Matfirst");
-			vm_a.copy(a);
-			vm_b.copy(b);
-			FFT_PROFILING(1,"Polfirst to Matfirst");
-
 			// Pointwise multiplication
-			for (size_t i = 0; i < pts; ++i){
-                auto vm_c_i = vm_c[i];
-				_BMD.mul(vm_c_i, vm_a[i], vm_b[i]);
-                vm_c.setMatrix(vm_c_i,i); // normally does nothing
-            }
+			pointwise(c, a, b);
 			FFT_PROFILING(1,"pointwise mult");
 
-			// Transformation into matrix of polynomials (with int32_t coefficient)
-			c.copy(vm_c);
-			FFT_PROFILING(1,"Matfirst to Polfirst");
-
-			// Inverse FFT on the output matrix
-			for (size_t i = 0; i < m * n; i++)
-				FFTer.FFT_inverse(&(c(i)[0]));
+			// Inverse FFT on the output matrix and division by pts = 2^lpts
+			FFT_inverse_all(FFTer, c);
 			FFT_PROFILING(1,"inverse FFT_DIT");
-
-			// Divide by pts = 2^ltps
-			typename Field::Element inv_pts;
-			field().init(inv_pts, pts);
-			field().invin(inv_pts);
-			// for (size_t i = 0; i < m * n; i++)
-			// 	for (size_t j = 0; j < pts; j++)
-			// 		field().mulin(c.ref(i,j), inv_pts);
-			FFLAS::fscalin(field(),c.rowdim()*c.coldim()*c.size(), inv_pts,  c.getPointer(),1);
-			FFT_PROFILING(1,"scaling the result");
 		}
 	}; // end of class special FFT mul domain
 
@@ -41,6 +41,7 @@ namespace LinBox
         const _Field                            *_field;
         PolynomialMatrixAddDomain<_Field>          _PMD;
         PolynomialMatrixNaiveMulDomain<_Field>     _NMD;
+        size_t                                    _base; // naive products below this size
         double _timeMul, _timeAdd;
 	public:
         typedef _Field Field;
@@ -51,7 +52,11 @@ namespace LinBox
         const Field & field() const { return *_field; }
 
         PolynomialMatrixKaraDomain(const Field &F) :
-            _field(&F), _PMD(F), _NMD(F){}
+            _field(&F), _PMD(F), _NMD(F), _base(KARA_DEG_THRESHOLD){}
+
+        // size of the operands below which the recursion stops
+        size_t threshold() const { return _base; }
+        void setThreshold(size_t t) { _base = std::max(t,size_t(1)); }
 
         // c must be allocated with the right size
         template<typename Matrix1,typename Matrix2,typename Matrix3>
@@ -136,7 +141,7 @@ namespace LinBox
         void Karatsuba_mul(PMatrix1 &C, const PMatrix2 &A, const PMatrix3& B, PMatrix4 &TMP) const {		
             //cout<<"Kar mul: "<<A.size()<<"x"<<B.size()<<"->"<<C.size()<<" ("<<TMP.size()<<")"<<endl;
             //cout<<"Kar:"<< A.rowdim()<<"x"<<A.coldim()<< "by "<<B.rowdim()<<"x"<<B.coldim()<<endl;            
-            if ((A.size() <=KARA_DEG_THRESHOLD) || (B.size()<=KARA_DEG_THRESHOLD)) {
+            if ((A.size() <=_base) || (B.size()<=_base)) {
 #ifdef KARA_TIMING
                 Givaro::Timer chrono;
                 chrono.start();
@@ -235,7 +240,7 @@ namespace LinBox
 
             //cout<<A.size()<<"x"<<B.size()<<"->"<<C.size()<<" ("<<TMP.size()<<")\n";
 
-            if ((A.size() <=KARA_DEG_THRESHOLD) || (B.size()<=KARA_DEG_THRESHOLD)) {
+            if ((A.size() <=_base) || (B.size()<=_base)) {
 #ifdef KARA_TIMING
                 Givaro::Timer chrono;
                 chrono.start();
@@ -79,8 +79,25 @@ namespace LinBox
             }
             // std::clog<<"C="<<c<<std::endl;
             // std::clog<<"-----------"<<std::endl;
-        }                          
-        
+        }
+
+        // c = a*b mod x^n, only the n first coefficients are computed
+        // c must have size >= min(n, a.size()+b.size()-1)
+        template<typename Matrix1,typename Matrix2,typename Matrix3>
+        void mul_trunc(Matrix1& c, const Matrix2&  a, const Matrix3&  b, size_t n) const
+        {
+            const size_t deg=std::min(n,a.size()+b.size()-1);
+            for (size_t k=0;k<deg;k++){
+                auto c_tmp=c[k];
+                size_t idx_min= (k+1<b.size()?0:k+1-b.size());
+                size_t idx_max=std::min(k,a.size()-1);
+                _BMD.mul(c_tmp,a[idx_min],b[k-idx_min]);
+                for (size_t i=idx_min+1;i<=idx_max;i++)
+                    _BMD.axpyin(c_tmp,a[i],b[k-i]);
+                c.setMatrix(c_tmp,k);
+            }
+        }
+
         template<typename Matrix1,typename Matrix2,typename Matrix3>
         void midproduct(Matrix1& c, const Matrix2&  a, const Matrix3&  b,
                         bool smallLeft=true, size_t n0=0,size_t n1=0) const
@@ -0,0 +1,238 @@
+/* linbox/algorithms/polynomial-matrix/matpoly-thresholds.h
+ * Copyright (C) 2020 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file algorithms/polynomial-matrix/matpoly-thresholds.h
+ * @ingroup algorithms
+ * @brief Crossover thresholds of the polynomial matrix multiplications and
+ * of the order basis, read at runtime from a per host profile.
+ *
+ * The profile is a text file, one line per field bit size:
+ * <code>bits kara fft mbasis</code>, lines starting with \c # being
+ * comments.  It is written by <code>benchmarks/benchmark-matpoly-thresholds</code>.
+ * The file is, in order of preference:
+ * - the value of the environment variable \c LINBOX_MATPOLY_THRESHOLDS,
+ * - <code>LINBOX_THRESHOLDS_DIR/matpoly-thresholds-<host>.txt</code> if
+ *   \c LINBOX_THRESHOLDS_DIR is defined.
+ *
+ * Without a profile the compile-time defaults below are used.
+ */
+
+#ifndef __LINBOX_matpoly_thresholds_H
+#define __LINBOX_matpoly_thresholds_H
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+#include <map>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#if defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))
+#include <unistd.h>
+#endif
+
+#include "linbox/integer.h"
+
+// naive product up to this size (a.size()+b.size())
+#ifndef KARA_DEG_THRESHOLD
+#define KARA_DEG_THRESHOLD 2
+#endif
+
+// Karatsuba product up to this size, FFT above
+#ifndef FFT_DEG_THRESHOLD
+#define FFT_DEG_THRESHOLD 2
+#endif
+
+// M-Basis up to this order, PM-Basis above
+// (the former MBASIS_THRESHOLD_LOG of order-basis.h still sets it)
+#if !defined(LINBOX_MBASIS_THRESHOLD)
+#if defined(MBASIS_THRESHOLD_LOG)
+#define LINBOX_MBASIS_THRESHOLD (1<<MBASIS_THRESHOLD_LOG)
+#else
+#define LINBOX_MBASIS_THRESHOLD 32
+#endif
+#endif
+
+namespace LinBox
+{
+
+	//! Crossover thresholds for one field bit size
+	struct MatpolyThresholds {
+		size_t kara;    //!< naive product while a.size()+b.size() <= kara
+		size_t fft;     //!< Karatsuba product while a.size()+b.size() <= fft
+		size_t mbasis;  //!< M-Basis while the order is <= mbasis (OrderBasis uses at least 1)
+
+		MatpolyThresholds(size_t k=KARA_DEG_THRESHOLD, size_t f=FFT_DEG_THRESHOLD, size_t m=LINBOX_MBASIS_THRESHOLD) :
+			kara(k), fft(f), mbasis(m)
+		{}
+
+		//! Karatsuba leaves: kara/2 coefficients, at least the former fixed leaf of 2
+		size_t karaLeaf() const { return std::max(kara/2, size_t(2)); }
+	};
+
+	/*! @brief Process-wide table of the thresholds, by field bit size.
+	 *
+	 * The table is loaded from \c defaultFile() on first use.  A lookup
+	 * returns the entry of the closest bit size, or the defaults when the
+	 * table is empty.
+	 */
+	class MatpolyThresholdProfile {
+	protected:
+		mutable std::mutex                  _mutex;
+		std::map<size_t, MatpolyThresholds> _table;
+
+		MatpolyThresholdProfile() {}
+
+	public:
+		MatpolyThresholdProfile(const MatpolyThresholdProfile&) = delete;
+		MatpolyThresholdProfile& operator=(const MatpolyThresholdProfile&) = delete;
+
+		//! The profile of the process, loaded on first use.
+		static MatpolyThresholdProfile& profile()
+		{
+			static MatpolyThresholdProfile* p = [] {
+				MatpolyThresholdProfile* q = new MatpolyThresholdProfile;
+				const std::string f = defaultFile();
+				if (! f.empty()) q->load(f);
+				return q;
+			}();
+			return *p;
+		}
+
+		static std::string hostname()
+		{
+#if defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))
+			char buf[256];
+			if (gethostname(buf, sizeof(buf)) == 0) {
+				buf[sizeof(buf)-1] = '\0';
+				return std::string(buf);
+			}
+#endif
+			return std::string("localhost");
+		}
+
+		//! The profile file of this host, empty if there is none.
+		static std::string defaultFile()
+		{
+			const char* env = std::getenv("LINBOX_MATPOLY_THRESHOLDS");
+			if (env != nullptr && *env != '\0')
+				return std::string(env);
+#ifdef LINBOX_THRESHOLDS_DIR
+			return std::string(LINBOX_THRESHOLDS_DIR) + "/matpoly-thresholds-" + hostname() + ".txt";
+#else
+			return std::string();
+#endif
+		}
+
+		//! bit size of the characteristic of \p F
+		template<class Field>
+		static size_t bitsize(const Field& F)
+		{
+			integer p;
+			F.characteristic(p);
+			return p.bitsize();
+		}
+
+		//! thresholds for fields of \p bits bits
+		MatpolyThresholds get(size_t bits) const
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (_table.empty()) return MatpolyThresholds();
+			auto hi = _table.lower_bound(bits);
+			if (hi == _table.end()) return std::prev(hi)->second;
+			if (hi == _table.begin() || hi->first == bits) return hi->second;
+			auto lo = std::prev(hi);
+			return (bits - lo->first < hi->first - bits) ? lo->second : hi->second;
+		}
+
+		//! thresholds for the field \p F
+		template<class Field>
+		MatpolyThresholds forField(const Field& F) const
+		{
+			return get(bitsize(F));
+		}
+
+		void set(size_t bits, const MatpolyThresholds& t)
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_table[bits] = t;
+		}
+
+		/*! Reads the entries of \p is, replacing the ones of the same bit size.
+		 * @return the number of entries read
+		 */
+		size_t load(std::istream& is)
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			size_t n = 0;
+			std::string line;
+			while (std::getline(is, line)) {
+				if (line.empty() || line[0] == '#') continue;
+				std::istringstream ls(line);
+				size_t bits;
+				MatpolyThresholds t;
+				if (ls >> bits >> t.kara >> t.fft >> t.mbasis) {
+					_table[bits] = t;
+					++n;
+				}
+			}
+			return n;
+		}
+
+		size_t load(const std::string& filename)
+		{
+			std::ifstream is(filename);
+			return is ? load(is) : 0;
+		}
+
+		std::ostream& write(std::ostream& os) const
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			os << "# bits kara fft mbasis (" << hostname() << ")\n";
+			for (auto& e : _table)
+				os << e.first << ' ' << e.second.kara << ' ' << e.second.fft << ' ' << e.second.mbasis << '\n';
+			return os;
+		}
+
+		bool save(const std::string& filename) const
+		{
+			std::ofstream os(filename);
+			if (! os) return false;
+			write(os);
+			return (bool)os;
+		}
+	};
+
+}
+
+#endif // __LINBOX_matpoly_thresholds_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
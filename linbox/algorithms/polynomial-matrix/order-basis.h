@@ -40,12 +40,11 @@
 #endif
 #include "linbox/algorithms/polynomial-matrix/polynomial-matrix-domain.h"
 #include <vector>
+#include <memory>
 #include <algorithm>
 #include <fstream>
 #include <chrono>
 #include "fflas-ffpack/fflas-ffpack.h"
-#define MBASIS_THRESHOLD_LOG 5
-#define MBASIS_THRESHOLD (1<<MBASIS_THRESHOLD_LOG)
 
 
 
@@ -67,7 +66,7 @@ namespace LinBox {
 #endif
 
 #ifndef __CHECK_PMBASIS_THRESHOLD 
-#define __CHECK_PMBASIS_THRESHOLD MBASIS_THRESHOLD
+#define __CHECK_PMBASIS_THRESHOLD LINBOX_MBASIS_THRESHOLD
 #endif        
 
 #if defined (__CHECK_MBASIS) or defined (__CHECK_PMBASIS)
@@ -77,16 +76,17 @@ namespace LinBox {
                 PolynomialMatrixMulDomain<Field> PMD(F);
                 MatrixDomain<Field> MD(F);
 #ifdef __PROBA_CHECK
-                Mat T(F,sigma.rowdim(),1,sigma.size()+serie.size()-1);
-                Mat U(F,serie.coldim(),1,1), serieU(F,serie.rowdim(),1,sigma.size()+serie.size()-1);
+                // only the coefficients of degree < ord are checked
+                Mat T(F,sigma.rowdim(),1,ord);
+                Mat U(F,serie.coldim(),1,1), serieU(F,serie.rowdim(),1,serie.size());
                 typename Field::RandIter Gen(F);
                 for (size_t i=0;i<serie.coldim();i++)
                         Gen.random(U.ref(i,0,0));
                 PMD.mul(serieU,serie,U);                
-                PMD.mul(T,sigma,serieU);
+                PMD.mul_trunc(T,sigma,serieU,ord);
 #else
-                Mat T(F,sigma.rowdim(),serie.coldim(),sigma.size()+serie.size()-1);
-                PMD.mul(T,sigma,serie);
+                Mat T(F,sigma.rowdim(),serie.coldim(),ord);
+                PMD.mul_trunc(T,sigma,serie,ord);
 #endif
 
                 size_t i=0;
@@ -186,6 +186,9 @@ namespace LinBox {
                 PolynomialMatrixMulDomain<Field>   _PMD;
                 BlasMatrixDomain<Field>            _BMD;
                 ET                           _EarlyStop;
+                size_t                          _mbasis; // M-Basis up to this order
+                size_t                        _memlimit; // bound on the workspace of PM_Basis_lean, in bytes (0: none)
+                size_t                       _workspace; // size of the last workspace of PM_Basis_lean, in bytes
         public:
 #if  defined(PROFILE_PMBASIS) or defined(__CHECK_MBASIS) or defined(__CHECK_PMBASIS)
                 size_t _idx=0;
@@ -194,11 +197,34 @@ namespace LinBox {
                 std::chrono::time_point<std::chrono::system_clock> _start, _end;
                 bool _started=false;
 #endif
-                OrderBasis(const Field& f) : _field(&f), _PMD(f), _BMD(f) {                 
+                OrderBasis(const Field& f) : _field(&f), _PMD(f), _BMD(f),
+                                             _memlimit(0), _workspace(0) {
+                        setMBasisThreshold(_PMD.thresholds().mbasis);
                 }
 
                 inline const Field& field() const {return *_field;}
 
+                // order up to which M-Basis is used instead of PM-Basis, at least 1
+                size_t mbasisThreshold() const {return _mbasis;}
+                void setMBasisThreshold(size_t t) {_mbasis=std::max(t,size_t(1));}
+
+                // bound on the workspace of PM_Basis_lean, in bytes (0: no bound)
+                size_t memoryLimit() const {return _memlimit;}
+                void setMemoryLimit(size_t bytes) {_memlimit=bytes;}
+
+                // workspace allocated by the last call to PM_Basis_lean, in bytes
+                size_t workspaceMemory() const {return _workspace;}
+
+                // workspace needed by PM_Basis_lean for a m x n serie up to order
+                size_t workspaceMemory(size_t m, size_t n, size_t order) const {
+                        size_t bytes=0;
+                        for (size_t o=order; o>std::max(_mbasis,size_t(1)); o-=o>>1){
+                                size_t o2=o-(o>>1);
+                                bytes+= (2*m*m*(o2+1)+m*n*o2)*element_storage(field());
+                        }
+                        return bytes;
+                }
+
                 // serie must have exactly order elements (i.e. its degree = order-1)
                 // sigma can have at most order+1 elements (i.e. its degree = order)
                 template<typename PMatrix1, typename PMatrix2>
@@ -229,7 +255,7 @@ namespace LinBox {
                         std::chrono::time_point<std::chrono::system_clock> _chrono_start=std::chrono::system_clock::now();
 #endif
                         
-                        if (order <= MBASIS_THRESHOLD) {
+                        if (order <= _mbasis) {
 #if defined (PROFILE_PMBASIS) or defined(__CHECK_PMBASIS)
                                 _idx+=order;
 #endif
@@ -324,6 +350,99 @@ namespace LinBox {
                                 return d1+d2;
                         }
                 }
+                // Same as PM_Basis, with a workspace allocated once: each level
+                // of the recursion has its buffers for sigma1, sigma2 and the
+                // serie update, sized for the largest order of the level and
+                // reused by all the calls of this level.  The first half of
+                // the serie is a view instead of a copy.  The workspace is
+                // about twice the size of sigma and serie at the top level,
+                // it is reported by workspaceMemory() and bounded by
+                // setMemoryLimit().
+                // serie must have exactly order elements (i.e. its degree = order-1)
+                // sigma can have at most order+1 elements (i.e. its degree = order)
+                template<typename PMatrix1, typename PMatrix2>
+                size_t PM_Basis_lean(PMatrix1                 &sigma,
+                                     const PMatrix2           &serie,
+                                     size_t                    order,
+                                     std::vector<size_t>       &shift)
+                {
+                        size_t m=sigma.rowdim();
+                        size_t n=serie.coldim();
+                        _workspace=workspaceMemory(m,n,order);
+#ifdef MEM_PMBASIS
+                        std::cerr<<"[PM-Basis lean ("<<order<<")] [Workspace] -> "<<MB(_workspace)<<"Mo"<<MEMINFO2<<std::endl;
+#endif
+                        if (_memlimit!=0 && _workspace>_memlimit)
+                                throw LinboxError("LinBox ERROR: OrderBasis: the workspace of PM-Basis exceeds the memory limit\n");
+
+                        PMBasisWorkspace<PMatrix1,PMatrix2> W;
+                        for (size_t o=order; o>std::max(_mbasis,size_t(1)); o-=o>>1){
+                                size_t o2=o-(o>>1);
+                                W.sigma1.emplace_back(new PMatrix1(field(),m,m,o2+1));
+                                W.sigma2.emplace_back(new PMatrix1(field(),m,m,o2+1));
+                                W.serie2.emplace_back(new PMatrix2(field(),m,n,o2));
+                        }
+                        return PM_Basis_ws(sigma,serie,order,shift,W,0);
+                }
+
+        protected:
+                template<typename PMatrix1, typename PMatrix2>
+                struct PMBasisWorkspace {
+                        std::vector<std::unique_ptr<PMatrix1> > sigma1, sigma2;
+                        std::vector<std::unique_ptr<PMatrix2> > serie2;
+                };
+
+                // resize a buffer of the workspace and set it to zero
+                template<typename PMatrix1>
+                void clear(PMatrix1 &M, size_t s) const {
+                        M.resize(s);
+                        for (size_t i=0;i<M.rowdim()*M.coldim();i++)
+                                for (size_t k=0;k<s;k++)
+                                        M.ref(i,k)=field().zero;
+                }
+
+                template<typename PMatrix1, typename PMatrix2, typename PMatrix3>
+                size_t PM_Basis_ws(PMatrix1                 &sigma,
+                                   const PMatrix3           &serie,
+                                   size_t                    order,
+                                   std::vector<size_t>       &shift,
+                                   PMBasisWorkspace<PMatrix1,PMatrix2> &W,
+                                   size_t                    level)
+                {
+                        if (order <= _mbasis)
+                                return M_Basis(sigma, serie, order, shift);
+
+                        size_t ord1,ord2,d1,d2;
+                        ord1 = order>>1;
+                        ord2 = order-ord1; // ord1+ord2=order
+                        PMatrix1 &sigma1=*W.sigma1[level];
+                        PMatrix1 &sigma2=*W.sigma2[level];
+                        PMatrix2 &serie2=*W.serie2[level];
+
+                        // first recursive call, on the first half of the serie
+                        clear(sigma1,ord1+1);
+                        d1 = PM_Basis_ws(sigma1, serie.at(0,ord1-1), ord1, shift, W, level+1);
+                        if (_EarlyStop.terminated()){
+                                sigma.resize(d1+1);
+                                sigma.copy(sigma1,0,d1);
+                                return d1;
+                        }
+
+                        // compute the serie update
+                        serie2.resize(ord2);
+                        _PMD.midproductgen(serie2, sigma1, serie, true, ord1+1,ord1+ord2);
+
+                        // second recursive call
+                        clear(sigma2,ord2+1);
+                        d2 = PM_Basis_ws(sigma2, serie2, ord2, shift, W, level+1);
+
+                        // compute the result
+                        sigma.resize(d1+d2+1);
+                        _PMD.mul(sigma, sigma2, sigma1);
+                        return d1+d2;
+                }
+
+        public:
                 // serie must have exactly order elements (i.e. its degree = order-1)
                 size_t M_Basis(MatrixP              &sigma,
                                const MatrixP        &serie,
@@ -647,7 +766,7 @@ namespace LinBox {
                         size_t log_order=integer(uint64_t(order)).bitsize();
 
                         //  leaf size of the recursive PM_Basis algorithm (must be a power of 2)
-                        size_t log_ord = MBASIS_THRESHOLD_LOG;
+                        size_t log_ord = integer(uint64_t(_mbasis)).bitsize()-1;
                         size_t ord     = std::min(size_t(1)<<log_ord ,order);
 
                         // prepare the storage for each serie update
@@ -761,7 +880,7 @@ namespace LinBox {
                         std::chrono::time_point<std::chrono::system_clock> _chrono_start=std::chrono::system_clock::now();
 #endif
                         
-                        if (order <= MBASIS_THRESHOLD) {
+                        if (order <= _mbasis) {
 #if defined (PROFILE_PMBASIS) or defined(__CHECK_PMBASIS)
                                 _idx+=order;
 #endif
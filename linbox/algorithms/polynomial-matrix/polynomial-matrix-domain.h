@@ -32,6 +32,7 @@
 #include "linbox/algorithms/polynomial-matrix/matpoly-mult-naive.h"
 #include "linbox/algorithms/polynomial-matrix/matpoly-mult-kara.h"
 #include "linbox/algorithms/polynomial-matrix/matpoly-mult-fft.h"
+#include "linbox/algorithms/polynomial-matrix/matpoly-thresholds.h"
 #include <algorithm>
 
 
@@ -45,29 +46,43 @@ namespace LinBox
 		PolynomialMatrixFFTMulDomain<_Field>      _fft;
 		PolynomialMatrixNaiveMulDomain<_Field>  _naive;
 		const _Field*                           _field;
+		MatpolyThresholds                  _thresholds;
 	public:
         typedef _Field Field; 
 		PolynomialMatrixMulDomain (const Field &F) :
-			_kara(F), _fft(F), _naive(F), _field(&F) {}
+			_kara(F), _fft(F), _naive(F), _field(&F),
+			_thresholds(MatpolyThresholdProfile::profile().forField(F))
+		{
+			_kara.setThreshold(_thresholds.karaLeaf());
+		}
 
 		inline const Field& field() const {return *_field;}
 
+		// crossovers in use, taken from the host profile at construction
+		const MatpolyThresholds& thresholds() const {return _thresholds;}
+		void setThresholds(const MatpolyThresholds& t) {
+			_thresholds=t;
+			_kara.setThreshold(t.karaLeaf());
+		}
+
 		template< class PMatrix1,class PMatrix2,class PMatrix3>
 		void mul(PMatrix1 &c, const PMatrix2 &a, const PMatrix3 &b, size_t max_rowdeg=0) const
 		{
 			size_t d = a.size()+b.size();
-            if (d > FFT_DEG_THRESHOLD){
-                    //std::cout<<"PolMul FFT"<<std::endl;
-				_fft.mul(c,a,b);
+			// Karatsuba only works for square matrices
+			bool square = a.rowdim()==a.coldim() && a.coldim()==b.rowdim() && b.rowdim()==b.coldim();
+            if (d <= _thresholds.kara){
+                    //std::cout<<"PolMul Naive"<<std::endl;
+				_naive.mul(c,a,b);
             }
 			else
-				if ( d > KARA_DEG_THRESHOLD){
+				if ( d <= _thresholds.fft && square){
                         //std::cout<<"PolMul Kara"<<std::endl;
 					_kara.mul(c,a,b);
                 }
 				else {
-                        //std::cout<<"PolMul Naive"<<std::endl;
-					_naive.mul(c,a,b);
+                        //std::cout<<"PolMul FFT"<<std::endl;
+					_fft.mul(c,a,b);
                 }
 #ifdef CHECK_MATPOL_MUL                       
             check_mul(c,a,b,c.size());
@@ -78,26 +93,54 @@ namespace LinBox
 		void midproduct (PMatrix1 &c, const PMatrix2 &a, const PMatrix3 &b) const
 		{
 			size_t d = b.size();
-			if (d > FFT_DEG_THRESHOLD)
-				_fft.midproduct(c,a,b);
+			bool square = a.rowdim()==a.coldim() && a.coldim()==b.rowdim() && b.rowdim()==b.coldim();
+			if (d <= _thresholds.kara)
+				_naive.midproduct(c,a,b);
 			else
-				if ( d > KARA_DEG_THRESHOLD)
+				if (d <= _thresholds.fft && square)
 					_kara.midproduct(c,a,b);
 				else
-					_naive.midproduct(c,a,b);
+					_fft.midproduct(c,a,b);
 #ifdef CHECK_MATPOL_MIDP                       
                         check_midproduct(c,a,b);
 #endif
 
 		}
 
+		// c = a*b mod x^n, only the n first coefficients of a and b are read
+		// c must have size >= min(n, a.size()+b.size()-1)
+		template< class PMatrix1,class PMatrix2,class PMatrix3>
+		void mul_trunc (PMatrix1 &c, const PMatrix2 &a, const PMatrix3 &b, size_t n) const
+		{
+			const size_t sa = std::min(a.size(),n), sb = std::min(b.size(),n);
+			const size_t d  = std::min(n,sa+sb-1);
+			if (d <= 4)
+				_naive.mul_trunc(c,a,b,n);
+			else {
+				// the product of the truncated inputs has size <= 2n-1
+				auto a0 = a.at(0,sa-1);
+				auto b0 = b.at(0,sb-1);
+				PolynomialMatrix<Field,PMType::polfirst> t(field(),c.rowdim(),c.coldim(),sa+sb-1);
+				mul(t,a0,b0);
+				c.copy(t,0,d-1);
+			}
+		}
+
 		template< class PMatrix1,class PMatrix2,class PMatrix3>
 		void midproductgen (PMatrix1 &c, const PMatrix2 &a, const PMatrix3 &b, bool smallLeft=true, size_t n0=0, size_t n1=0) const
 		{
-			if ( c.size() <= 4)
+			size_t d = b.size();
+			// Karatsuba only handles the default middle product of square matrices
+			bool kara = smallLeft && (n0==0 || n0==c.size()) && (n1==0 || n1==2*c.size()-1)
+				&& a.size()==c.size() && b.size()==2*c.size()-1
+				&& a.rowdim()==a.coldim() && a.coldim()==b.rowdim() && b.rowdim()==b.coldim();
+			if ( c.size() <= 4 || d <= _thresholds.kara)
 				_naive.midproduct(c,a,b,smallLeft,n0,n1);
 			else
-				_fft.midproduct(c,a,b,smallLeft,n0,n1);
+				if (d <= _thresholds.fft && kara)
+					_kara.midproduct(c,a,b);
+				else
+					_fft.midproduct(c,a,b,smallLeft,n0,n1);
 #ifdef CHECK_MATPOL_MIDP                       
                         check_midproduct(c,a,b,smallLeft,n0,n1);
 #endif               
@@ -0,0 +1,328 @@
+/* linbox/algorithms/polynomial-matrix/popov-form.h
+ * Copyright (C) 2020 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file algorithms/polynomial-matrix/popov-form.h
+ * @ingroup algorithms
+ * @brief Row reduced and ordered weak Popov forms of nonsingular
+ * polynomial matrices, with order bases and matrix products.
+ *
+ * For \f$M\f$ of size \f$m\times m\f$ and degree \f$d\f$, the rows
+ * \f$[U\,|\,R]\f$ of a minimal kernel basis of \f$[M; -I]\f$ for the shift
+ * \f$(0,\dots,0,D,\dots,D)\f$, \f$D=(m-1)d+1\f$, satisfy \f$R=UM\f$ with
+ * \f$U\f$ unimodular and \f$R\f$ row reduced.  This kernel basis is made
+ * of the rows of shifted degree at most \f$d+D\f$ of an order basis of
+ * order \f$2d+D+1\f$ (OrderBasis::PM_Basis).
+ *
+ * As this order is about \f$(m+1)d\f$, the cost is
+ * \f$O\tilde{~}(m^{\omega+1}d)\f$, a factor \f$m\f$ above the
+ * \f$O\tilde{~}(m^{\omega}d)\f$ of the row reductions by partial
+ * linearization of the shift, which are not implemented here.  For
+ * \f$m\gtrsim d\f$ it can be slower than an elimination over
+ * \f$K[x]\f$.
+ *
+ * The weak Popov form is then obtained from the leading matrix of
+ * \f$R\f$: an elimination on this constant matrix, rows taken by
+ * increasing degree, gives a transformation \f$T_{il}=E_{il}x^{d_i-d_l}\f$
+ * applied to \f$R\f$ with one matrix product per coefficient and per
+ * distinct degree difference.
+ */
+
+#ifndef __LINBOX_matpoly_popov_form_H
+#define __LINBOX_matpoly_popov_form_H
+
+#include <vector>
+#include <map>
+#include <numeric>
+#include <algorithm>
+
+#include "linbox/util/error.h"
+#include "linbox/util/debug.h"
+#include "linbox/matrix/dense-matrix.h"
+#include "linbox/matrix/polynomial-matrix.h"
+#include "linbox/matrix/matrixdomain/blas-matrix-domain.h"
+#include "linbox/algorithms/polynomial-matrix/order-basis.h"
+
+namespace LinBox
+{
+	template<class _Field>
+	class PolynomialMatrixPopovDomain {
+	public:
+		typedef _Field                                     Field;
+		typedef typename Field::Element                  Element;
+		typedef PolynomialMatrix<Field, PMType::polfirst> MatrixP;
+		typedef PolynomialMatrix<Field, PMType::matfirst> PMatrix;
+		typedef BlasMatrix<Field>                         Matrix;
+
+	private:
+		const Field*             _field;
+		BlasMatrixDomain<Field>    _BMD;
+		OrderBasis<Field>           _OB;
+
+	public:
+		PolynomialMatrixPopovDomain(const Field& F) : _field(&F), _BMD(F), _OB(F) {}
+
+		inline const Field& field() const { return *_field; }
+
+		//! order basis used for the kernel, e.g. to set its thresholds
+		OrderBasis<Field>& orderBasis() { return _OB; }
+
+		//! degrees of the rows of \p M, -1 for a zero row
+		template<class PMat>
+		void rowDegrees(std::vector<long>& rdeg, const PMat& M) const
+		{
+			rdeg.assign(M.rowdim(), -1);
+			for (size_t i = 0; i < M.rowdim(); ++i)
+				for (size_t j = 0; j < M.coldim(); ++j)
+					for (long k = (long)M.size()-1; k > rdeg[i]; --k)
+						if (!field().isZero(M.get(i, j, (size_t)k))) {
+							rdeg[i] = k;
+							break;
+						}
+		}
+
+		//! coefficients of degree \p rdeg[i] of the rows of \p M, zero rows for zero rows
+		template<class PMat>
+		void leadingMatrix(Matrix& L, const PMat& M, const std::vector<long>& rdeg) const
+		{
+			for (size_t i = 0; i < M.rowdim(); ++i)
+				for (size_t j = 0; j < M.coldim(); ++j)
+					L.setEntry(i, j, (rdeg[i] < 0) ? field().zero : M.get(i, j, (size_t)rdeg[i]));
+		}
+
+		/*! weak Popov pivots of \p M: index of the rightmost entry of
+		 * maximal degree of each row, -1 for a zero row.
+		 */
+		template<class PMat>
+		void pivots(std::vector<long>& piv, const PMat& M) const
+		{
+			std::vector<long> rdeg;
+			rowDegrees(rdeg, M);
+			piv.assign(M.rowdim(), -1);
+			for (size_t i = 0; i < M.rowdim(); ++i)
+				if (rdeg[i] >= 0)
+					for (size_t j = 0; j < M.coldim(); ++j)
+						if (!field().isZero(M.get(i, j, (size_t)rdeg[i])))
+							piv[i] = (long)j;
+		}
+
+		//! true if the nonzero rows of \p M have distinct pivots (increasing if \p ordered)
+		template<class PMat>
+		bool isWeakPopov(const PMat& M, bool ordered=false) const
+		{
+			std::vector<long> piv;
+			pivots(piv, M);
+			std::vector<bool> used(M.coldim(), false);
+			long last = -1;
+			for (size_t i = 0; i < piv.size(); ++i) {
+				if (piv[i] < 0) continue;
+				if (used[(size_t)piv[i]] || (ordered && piv[i] < last)) return false;
+				used[(size_t)piv[i]] = true;
+				last = piv[i];
+			}
+			return true;
+		}
+
+		/*! R = U M row reduced, \p M square nonsingular.
+		 * \p R (and \p U if not null) must be \f$m\times m\f$, they are
+		 * resized.  The row degrees of \p R are at most the ones of \p M.
+		 * Cost \f$O\tilde{~}(m^{\omega+1}d)\f$, see above.
+		 * @throws LinboxMathSingularMatrix if \p M is singular
+		 */
+		void rowReduced(MatrixP& R, const MatrixP& M, MatrixP* U=nullptr)
+		{
+			const Field& F = field();
+			const size_t m = M.rowdim();
+			if (M.coldim() != m)
+				throw LinboxError("LinBox ERROR: row reduced form of a non square polynomial matrix.\n");
+
+			std::vector<long> rdeg;
+			rowDegrees(rdeg, M);
+			const long dmax = *std::max_element(rdeg.begin(), rdeg.end());
+			if (dmax < 0 || *std::min_element(rdeg.begin(), rdeg.end()) < 0)
+				throw LinboxMathSingularMatrix("LinBox ERROR: polynomial matrix is singular.\n");
+			const size_t d = (size_t)dmax;
+			const size_t D = (m-1)*d+1;
+			const size_t order = 2*d+D+1;
+
+			// serie = [M; -I]
+			MatrixP serie(F, 2*m, m, order);
+			for (size_t i = 0; i < m; ++i)
+				for (size_t j = 0; j < m; ++j)
+					for (size_t k = 0; k <= d; ++k)
+						F.assign(serie.ref(i, j, k), M.get(i, j, k));
+			for (size_t i = 0; i < m; ++i)
+				F.neg(serie.ref(m+i, i, 0), F.one);
+
+			MatrixP sigma(F, 2*m, 2*m, order+1);
+			std::vector<size_t> shift(2*m, 0);
+			std::fill(shift.begin()+m, shift.end(), D);
+			_OB.PM_Basis(sigma, serie, order, shift);
+
+			// the rows of shifted degree at most d+D form the kernel basis
+			std::vector<size_t> rows;
+			for (size_t i = 0; i < 2*m; ++i)
+				if (shift[i] <= d+D)
+					rows.push_back(i);
+			if (rows.size() != m)
+				throw LinboxMathSingularMatrix("LinBox ERROR: polynomial matrix is singular.\n");
+
+			// sigma is resized to its actual degree
+			const size_t sr = std::min(d+1, sigma.size());
+			setZero(R, m, d+1);
+			for (size_t t = 0; t < m; ++t)
+				for (size_t j = 0; j < m; ++j)
+					for (size_t k = 0; k < sr; ++k)
+						F.assign(R.ref(t, j, k), sigma.get(rows[t], m+j, k));
+			if (U != nullptr) {
+				const size_t su = std::min(d+D+1, sigma.size());
+				setZero(*U, m, su);
+				for (size_t t = 0; t < m; ++t)
+					for (size_t j = 0; j < m; ++j)
+						for (size_t k = 0; k < su; ++k)
+							F.assign(U->ref(t, j, k), sigma.get(rows[t], j, k));
+			}
+		}
+
+		/*! W = U M in ordered weak Popov form, \p M square nonsingular.
+		 * \p W (and \p U if not null) must be \f$m\times m\f$, they are
+		 * resized.
+		 * @return the row degrees of \p W
+		 * @throws LinboxMathSingularMatrix if \p M is singular
+		 */
+		std::vector<size_t> weakPopov(MatrixP& W, const MatrixP& M, MatrixP* U=nullptr)
+		{
+			const Field& F = field();
+			const size_t m = M.rowdim();
+			MatrixP R(F, m, m, 1), U0(F, m, m, 1);
+			rowReduced(R, M, (U != nullptr) ? &U0 : nullptr);
+
+			std::vector<long> rdeg;
+			rowDegrees(rdeg, R);
+			Matrix L(F, m, m), E(F, m, m);
+			leadingMatrix(L, R, rdeg);
+			for (size_t i = 0; i < m; ++i)
+				E.setEntry(i, i, F.one);
+
+			// rows by increasing degree, each row is reduced by the previous ones
+			// until the rightmost nonzero entry of its leading vector is a new pivot
+			std::vector<size_t> ord(m);
+			std::iota(ord.begin(), ord.end(), 0);
+			std::stable_sort(ord.begin(), ord.end(), [&](size_t a, size_t b) { return rdeg[a] < rdeg[b]; });
+			std::vector<long> owner(m, -1), piv(m, -1);
+			for (size_t i : ord) {
+				for (;;) {
+					long c = (long)m-1;
+					while (c >= 0 && F.isZero(L.getEntry(i, (size_t)c))) --c;
+					if (c < 0)
+						throw LinboxMathSingularMatrix("LinBox ERROR: polynomial matrix is singular.\n");
+					const long j = owner[(size_t)c];
+					if (j < 0) {
+						owner[(size_t)c] = (long)i;
+						piv[i] = c;
+						break;
+					}
+					Element a;
+					F.div(a, L.getEntry(i, (size_t)c), L.getEntry((size_t)j, (size_t)c));
+					for (size_t l = 0; l < m; ++l) {
+						Element t;
+						F.mul(t, a, L.getEntry((size_t)j, l));
+						F.subin(L.refEntry(i, l), t);
+						F.mul(t, a, E.getEntry((size_t)j, l));
+						F.subin(E.refEntry(i, l), t);
+					}
+				}
+			}
+
+			// ordered: row t of the result is the row of pivot t
+			Matrix PE(F, m, m);
+			std::vector<long> rdegOut(m);
+			for (size_t t = 0; t < m; ++t) {
+				const size_t i = (size_t)owner[t];
+				rdegOut[t] = rdeg[i];
+				for (size_t l = 0; l < m; ++l)
+					PE.setEntry(t, l, E.getEntry(i, l));
+			}
+
+			setZero(W, m, R.size());
+			applyTransform(W, PE, rdegOut, rdeg, R);
+			if (U != nullptr) {
+				const long maxdelta = *std::max_element(rdeg.begin(), rdeg.end())
+					- *std::min_element(rdeg.begin(), rdeg.end());
+				setZero(*U, m, U0.size()+(size_t)maxdelta);
+				applyTransform(*U, PE, rdegOut, rdeg, U0);
+			}
+			return std::vector<size_t>(rdegOut.begin(), rdegOut.end());
+		}
+
+	protected:
+		// M = 0, with s coefficients
+		void setZero(MatrixP& M, size_t m, size_t s) const
+		{
+			M.resize(s);
+			for (size_t i = 0; i < m*M.coldim(); ++i)
+				for (size_t k = 0; k < s; ++k)
+					field().assign(M.ref(i, k), field().zero);
+		}
+
+		/* Out = T In with T_il = E_il x^(rdegOut_i - rdegIn_l), the
+		 * exponents being nonnegative for the nonzero E_il.  One product
+		 * by a constant matrix per coefficient and per exponent.
+		 */
+		void applyTransform(MatrixP& Out, const Matrix& E, const std::vector<long>& rdegOut,
+							const std::vector<long>& rdegIn, const MatrixP& In) const
+		{
+			const Field& F = field();
+			const size_t m = E.rowdim();
+			std::map<size_t, Matrix> Ed;
+			for (size_t i = 0; i < m; ++i)
+				for (size_t l = 0; l < m; ++l) {
+					if (F.isZero(E.getEntry(i, l)) || rdegIn[l] < 0) continue;
+					linbox_check(rdegOut[i] >= rdegIn[l]);
+					const size_t delta = (size_t)(rdegOut[i]-rdegIn[l]);
+					auto it = Ed.find(delta);
+					if (it == Ed.end())
+						it = Ed.emplace(delta, Matrix(F, m, m)).first;
+					it->second.setEntry(i, l, E.getEntry(i, l));
+				}
+
+			PMatrix In2(F, m, In.coldim(), In.size()), Out2(F, m, Out.coldim(), Out.size());
+			In2.copy(In);
+			for (auto& e : Ed)
+				for (size_t k = e.first; k < Out2.size() && k-e.first < In2.size(); ++k) {
+					auto Ok = Out2[k];
+					_BMD.axpyin(Ok, e.second, In2[k-e.first]);
+				}
+			Out.copy(Out2);
+		}
+	};
+
+} // end of namespace LinBox
+
+#endif // __LINBOX_matpoly_popov_form_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -27,16 +27,21 @@
 
 #include "givaro/zring.h"
 #include "linbox/algorithms/cra-builder-full-multip.h"
+#include "linbox/algorithms/cra-builder-full-multip-tree.h"
 
 namespace LinBox
 {
 
-	template<class Domain_Type>
-	struct RationalCRABuilderFullMultip : public virtual CRABuilderFullMultip<Domain_Type> {
+	/*! Rational reconstruction of the result of a full multip builder.
+	 * @tparam Father_Type the integer builder, CRABuilderFullMultip or
+	 * CRABuilderFullMultipTree for large numbers of primes.
+	 */
+	template<class Domain_Type, class Father_Type = CRABuilderFullMultip<Domain_Type> >
+	struct RationalCRABuilderFullMultip : public virtual Father_Type {
 		typedef Domain_Type				Domain;
-		typedef CRABuilderFullMultip<Domain> 			Father_t;
+		typedef Father_Type 			Father_t;
 		typedef typename Father_t::DomainElement 	DomainElement;
-		typedef RationalCRABuilderFullMultip<Domain>		Self_t;
+		typedef RationalCRABuilderFullMultip<Domain,Father_t>		Self_t;
 		Givaro::ZRing<Integer> _ZZ;
 	public:
 
@@ -37,7 +37,9 @@
 #include "linbox/matrix/dense-matrix.h"
 #include "linbox/matrix/factorized-matrix.h"
 
-#include "linbox/algorithms/matpoly-mult.h"
+#include "linbox/matrix/polynomial-matrix.h"
+#include "linbox/algorithms/polynomial-matrix/polynomial-matrix-domain.h"
+#include "linbox/algorithms/polynomial-matrix/order-basis.h"
 #include "linbox/solutions/echelon.h"
 #include "linbox/vector/subvector.h"
 #include "linbox/util/timer.h"
@@ -47,8 +49,12 @@
 
 /*! @file algorithms/sigma-basis.h
  * @brief \f$\sigma\f$-basis (minimal basis).
+ *
+ * The series and the bases are vectors of BlasMatrix coefficients.  The
+ * divide and conquer basis, the series updates and the basis products
+ * copy them once into contiguous polynomial matrices and use OrderBasis
+ * and PolynomialMatrixMulDomain (Karatsuba and FFT products).
  */
-#define MBASIS_THRESHOLD 16
 
 namespace LinBox
 {
@@ -67,6 +73,7 @@ namespace LinBox
 		typedef _Field                           Field;
 		typedef typename Field::Element        Element;
 		typedef BlasMatrix<Field>          Coefficient;
+		typedef PolynomialMatrix<Field,PMType::matfirst> PMatrix;
 
 		inline const Field & field() const { return *_field; }
 	private:
@@ -74,7 +81,9 @@ namespace LinBox
 		BlasMatrixDomain<Field>         _BMD;
 		MatrixDomain<Field>              _MD;
 		std::vector<Coefficient>     &_Serie;
-		PolynomialMatrixDomain<Field > PM_domain;
+		PolynomialMatrixMulDomain<Field> _PMD;
+		OrderBasis<Field>                 _OB;
+		Timer                        multime;
 
 #ifdef _BM_TIMING
 		mutable Timer ttMBasis              , tMBasis,
@@ -136,8 +145,9 @@ namespace LinBox
 	public:
 
 		SigmaBasis(const Field &F, std::vector<Coefficient> &PowerSerie) :
-			_field(&F), _BMD(F), _MD(F), _Serie(PowerSerie), PM_domain(F)
+			_field(&F), _BMD(F), _MD(F), _Serie(PowerSerie), _PMD(F), _OB(F)
 		{
+			multime.clear();
 #ifdef  _BM_TIMING
 			clearTimer();
 #endif
@@ -216,7 +226,7 @@ namespace LinBox
 
 			// Update Serie to compute Sigma base up to degree1 - degree2
 			std::vector<Coefficient> Serie2(degree2-degree1+1,ZeroSerie);
-			ComputeNewSerieClassic(Serie2,SigmaBase1, _Serie, degree1, degree2-degree1);
+			ComputeNewSerie(Serie2,SigmaBase1, _Serie, degree1, degree2-degree1);
 
 			// Compute Sigma Base up to degree2
 			std::vector<Coefficient> Sigma2(degree2-degree1+1, Zero);
@@ -263,7 +273,7 @@ namespace LinBox
 
 			// Update Serie to compute Sigma base up to degree1 - degree2
 			std::vector<Coefficient> Serie2(degree2-degree1+1,TransposedZero);
-			ComputeNewSerieClassic(Serie2,SigmaBase1, TransposedSerie, degree1, degree2-degree1);
+			ComputeNewSerie(Serie2,SigmaBase1, TransposedSerie, degree1, degree2-degree1);
 
 			// Compute Sigma Base up to degree2
 			std::vector<Coefficient> Sigma2(degree2-degree1+1, Zero);
@@ -392,8 +402,6 @@ namespace LinBox
 			size_t m,n;
 			m = PowerSerie[0].rowdim();
 			n = PowerSerie[0].coldim();
-			const Coefficient ZeroSigma(field(),m,m);
-			const Coefficient ZeroSerie(field(),m,n);
 
 			if (degree == 0) {
 				Coefficient Identity(field(),m,m);
@@ -403,75 +411,27 @@ namespace LinBox
 			}
 
 			else {
-
-				if (degree <= MBASIS_THRESHOLD) {
-#ifdef _BM_TIMING
-					tMBasis.clear();tMBasis.start();
-#endif
-					M_Basis(SigmaBase, PowerSerie, degree, defect);
-#ifdef _BM_TIMING
-					tMBasis.stop();	ttMBasis += tMBasis;
-#endif
-				}
-
-				else {
-					size_t degree1,degree2,shift;
-					shift=(degree & 0x1);
-					degree1 = (degree >> 1) + shift;
-					degree2 = degree - degree1;
-
-					// Compute Sigma Base of half degree
-					std::vector<Coefficient> Sigma1(degree1+1,ZeroSigma);
-
-					std::vector<Coefficient> Serie1(degree1+1,ZeroSerie);
-					for (size_t i=0;i< degree1+1;++i)
-						Serie1[i] = PowerSerie[i];
-
-					//Subvector<typename Polynomial2::iterator> Serie1(PowerSerie.begin(),PowerSerie.begin()+degree1);
-					PM_Basis(Sigma1, Serie1, degree1, defect);
-					// !!! NEED TO RESIZE SIGMA1
-					// because MBasis remove all 0 matrix from leading coefficient of SigmaBase
-					// while PM_Basis does not
-					Sigma1.resize(degree1+1,ZeroSigma);
-#ifdef _BM_TIMING
-					tUpdateSerie.clear();tUpdateSerie.start();
-#endif
-					// Compute Serie2 = x^(-degree1).Sigma.PowerSerie mod x^degree2
-					// degree1 instead degree2 for using middle product computation
-					std::vector<Coefficient> Serie2(degree1+1,ZeroSerie);
-
-					//if (2*Sigma1.size() !=  PowerSerie.size()+1)
-					//std::cerr<<Sigma1.size()<<" "<<PowerSerie.size()<<" marche pas\n";
-
-
-					//PM_domain.midproduct(Serie2,Sigma1,PowerSerie);
-					ComputeNewSerie(Serie2,Sigma1,PowerSerie, degree1, degree2);
-					Serie2.resize(degree2+1,ZeroSerie);
-
-#ifdef _BM_TIMING
-					tUpdateSerie.stop();ttUpdateSerie += tUpdateSerie;
-#endif
-					// Compute Sigma Base of half degree from updated Power Serie
-					std::vector<Coefficient> Sigma2(degree2+1,ZeroSigma);
-
-					PM_Basis(Sigma2, Serie2, degree2, defect);
-
 #ifdef _BM_TIMING
-					tBasisMultiplication.clear();tBasisMultiplication.start();
+				tMBasis.clear();tMBasis.start();
 #endif
-					// Compute the whole Sigma Base: SigmaBase= Sigma1 x Sigma2
-					PM_domain.mul(SigmaBase,Sigma2,Sigma1);
+				// M-Basis below the threshold of the order basis, PM-Basis
+				// with Karatsuba/FFT products and middle products above
+				PMatrix Serie(field(),m,n,degree), Sigma(field(),m,m,degree+1);
+				toPolynomialMatrix(Serie, PowerSerie, degree);
+				_OB.PM_Basis(Sigma, Serie, degree, defect);
+
+				// the basis may be shorter than degree+1
+				fromPolynomialMatrix(SigmaBase, Sigma, std::max(SigmaBase.size(), Sigma.size()));
 #ifdef _BM_TIMING
-					tBasisMultiplication.stop();ttBasisMultiplication += tBasisMultiplication;
+				tMBasis.stop();	ttMBasis += tMBasis;
 #endif
-				}
 			}
 		}
 
 
 		void print_multime()
 		{
-			std::cout<<"multime: "<<PM_domain.multime<<std::endl;
+			std::cout<<"multime: "<<multime<<std::endl;
 		}
 
 		// Computation of a minimal Sigma Base of a Power Serie up to length
@@ -662,38 +622,15 @@ namespace LinBox
 
 		// Multiply a Power Serie by a Sigma Base.
 		// only affect coefficients of the Power Serie between degree1 and degree1+degree2
+		// NewSerie[i] = sum_j SigmaBase[j].OldSerie[degree1+i-j], i=0..degree2
 		template<class Polynomial1, class Polynomial2,class Polynomial3>
 		inline void ComputeNewSerie(Polynomial1          &NewSerie,
 					    const Polynomial2   &SigmaBase,
 					    const Polynomial3    &OldSerie,
-					    size_t                 , //deg1
-					    size_t                 )//deg2
+					    size_t                 degree1,
+					    size_t                 degree2)
 		{
-
-			// degree1 >= degree2
-			//size_t size = 2*degree1 + 1;
-
-			const Coefficient ZeroSerie (field(),OldSerie[0].rowdim(), OldSerie[0].coldim());
-			//const Coefficient ZeroBase  (SigmaBase[0].rowdim(), SigmaBase[0].coldim());
-
-			// Work on a copy of the old  Serie (increase size by one for computation of middle product)
-
-			std::vector<Coefficient> Serie(OldSerie.size()+1, ZeroSerie);
-			for (size_t i=0;i< OldSerie.size();++i)
-				Serie[i] = OldSerie[i];
-			Serie[OldSerie.size()]=ZeroSerie;
-
-			//  ** try to not use a Copy **
-			// Work on a copy of the Sigma Base
-#if 0
-			std::vector<Coefficient> Sigma(SigmaBase.size());
-			for (size_t i=0;i<SigmaBase.size();++i){
-				Sigma[i] = SigmaBase[i];
-			}
-#endif
-
-
-			PM_domain.midproduct(NewSerie, SigmaBase, Serie);
+			midproduct(NewSerie, SigmaBase, OldSerie, degree1, degree1+degree2+1);
 		}
 
 
@@ -717,7 +654,7 @@ namespace LinBox
 		void MulSigmaBasis(std::vector<Coefficient> &C,
 				   std::vector<Coefficient> &A,
 				   std::vector<Coefficient> &B)
-		{PM_domain.mul(C,A,B);}
+		{mul(C,A,B);}
 
 
 		void PadeApproximant (std::vector<Coefficient>            &Approx,
@@ -1952,7 +1889,7 @@ namespace LinBox
 					//resize SigmaBase
 					SigmaBase.resize(Sigma1.size()+Sigma2.size()-1, ZeroSigma);
 
-					PM_domain.mul(SigmaBase,Sigma2,Sigma1);
+					mul(SigmaBase,Sigma2,Sigma1);
 
 					// Remove leading Zero coefficient of SigmaBase
 					size_t idx;
@@ -1981,11 +1918,6 @@ namespace LinBox
 				 size_t                                    degree2)
 		{
 
-			size_t m,n;
-			m = OldSerie[0].rowdim();
-			n = OldSerie[0].coldim();
-			const Coefficient ZeroSigma(field(),m,m);
-			const Coefficient ZeroSerie(field(),m,n);
 			size_t Ssize = SigmaBase.size();
 
 			if (SigmaBase.size() < 5){
@@ -1998,24 +1930,73 @@ namespace LinBox
 				}
 			}
 			else{
-				//std::cout<<"Sigma size: "<<Ssize<<" -> "<<degree1<<" -> "<<degree2<<"\n";
-				// resize to fit the requirement of middle product algorithm
-				SigmaBase.resize(degree1+1, ZeroSigma);
-				NewSerie.resize (degree1+1, ZeroSerie);
-				std::vector<Coefficient> Serie(2*degree1+1,ZeroSerie);
-				for (size_t i=0;i< OldSerie.size();++i)
-					Serie[i] = OldSerie[i];
-
-				// call middle product
-				PM_domain.midproduct(NewSerie, SigmaBase, Serie);
-
-				// resize results and entries
-				NewSerie.resize(degree2, ZeroSerie);
-				SigmaBase.resize(Ssize, ZeroSigma);
+				// middle product, coefficients degree1..degree1+degree2-1
+				midproduct(NewSerie, SigmaBase, OldSerie, degree1, degree1+degree2);
 			}
 		}
 
 
+		// P = V[0..s-1], P having s coefficients
+		template<class Polynomial>
+		void toPolynomialMatrix(PMatrix &P, const Polynomial &V, size_t s) const
+		{
+			const size_t r = P.rowdim(), c = P.coldim();
+			for (size_t k=0;k<std::min(s,(size_t)V.size());++k)
+				FFLAS::fassign(field(), r, c, V[k].getPointer(), V[k].getStride(),
+					       P.getPointer()+k*r*c, c);
+		}
+
+		// V[0..s-1] = P, the coefficients beyond the size of P being zero
+		template<class Polynomial>
+		void fromPolynomialMatrix(Polynomial &V, const PMatrix &P, size_t s) const
+		{
+			const size_t r = P.rowdim(), c = P.coldim();
+			V.resize(s, Coefficient(field(), r, c));
+			for (size_t k=0;k<s;++k)
+				if (k < P.size())
+					FFLAS::fassign(field(), r, c, P.getPointer()+k*r*c, c,
+						       V[k].getPointer(), V[k].getStride());
+				else
+					FFLAS::fzero(field(), r, c, V[k].getPointer(), V[k].getStride());
+		}
+
+		// C = A.B, C having at least A.size()+B.size()-1 coefficients
+		template<class Polynomial1, class Polynomial2, class Polynomial3>
+		void mul(Polynomial1 &C, const Polynomial2 &A, const Polynomial3 &B)
+		{
+			Timer chrono;
+			chrono.start();
+			PMatrix A1(field(), A[0].rowdim(), A[0].coldim(), A.size());
+			PMatrix B1(field(), B[0].rowdim(), B[0].coldim(), B.size());
+			PMatrix C1(field(), A[0].rowdim(), B[0].coldim(), A.size()+B.size()-1);
+			toPolynomialMatrix(A1, A, A.size());
+			toPolynomialMatrix(B1, B, B.size());
+			_PMD.mul(C1, A1, B1);
+			fromPolynomialMatrix(C, C1, std::max((size_t)C.size(), C1.size()));
+			chrono.stop();
+			multime += chrono;
+		}
+
+		// C[i] = coefficient n0+i of A.B, for n0+i < n1, A having at most n0+1 coefficients
+		template<class Polynomial1, class Polynomial2, class Polynomial3>
+		void midproduct(Polynomial1 &C, const Polynomial2 &A, const Polynomial3 &B, size_t n0, size_t n1)
+		{
+			linbox_check(A.size() <= n0+1 && n0 < n1);
+			Timer chrono;
+			chrono.start();
+			const size_t sb = std::min((size_t)B.size(), n1);
+			PMatrix A1(field(), A[0].rowdim(), A[0].coldim(), A.size());
+			PMatrix B1(field(), B[0].rowdim(), B[0].coldim(), sb);
+			PMatrix C1(field(), A[0].rowdim(), B[0].coldim(), n1-n0);
+			toPolynomialMatrix(A1, A, A.size());
+			toPolynomialMatrix(B1, B, sb);
+			_PMD.midproductgen(C1, A1, B1, true, n0+1, n1);
+			fromPolynomialMatrix(C, C1, n1-n0);
+			chrono.stop();
+			multime += chrono;
+		}
+
+
 		void write_maple(const char* name, const Coefficient & C)
 		{
 			size_t m,n;
@@ -27,7 +27,10 @@
 #define __LINBOX_pp_gauss_H
 
 #include <map>
+#include <vector>
+#include <algorithm>
 #include <givaro/givconfig.h> // for Signed_Trait
+#include "fflas-ffpack/paladin/parallel.h"
 #include "linbox/solutions/smith-form.h"
 #include "linbox/algorithms/gauss.h"
 
@@ -52,6 +55,12 @@
 #  endif
 #endif
 
+// Below this number of rows to eliminate against a pivot,
+// PARALLEL_ELIMINATION proceeds sequentially
+#ifndef LINBOX_pp_gauss_PARALLEL_THRESHOLD
+#  define LINBOX_pp_gauss_PARALLEL_THRESHOLD 256
+#endif
+
 
 namespace LinBox
 {
@@ -68,9 +77,67 @@ namespace LinBox
             // Combine these in binary for use in StaticParameters
         PRIVILEGIATE_NO_COLUMN_PIVOTING	= 1,
         PRIVILEGIATE_REDUCING_FILLIN	= 2,
-        PRESERVE_UPPER_MATRIX		= 4
+        PRESERVE_UPPER_MATRIX		= 4,
+        PARALLEL_ELIMINATION		= 8
     };
 
+        // Column density accessed by position in the pivot row:
+        // every density change made by an elimination step occurs
+        // in a column where the pivot row has a non-zero.
+    template<class Vecteur, class De>
+    struct PivotColumnDensity {
+        De& _columns;
+        const Vecteur& _lignepivot;
+        PivotColumnDensity(De& columns, const Vecteur& lignepivot) :
+                _columns(columns), _lignepivot(lignepivot) {}
+        typename De::value_type& operator[](size_t l) {
+            return _columns[ _lignepivot[l].first ];
+        }
+    };
+
+        // Eliminates column k of the rows below the pivot row.
+        // Rows having a non-zero in column k are batched first,
+        // then the batch is split in chunks run as tasks of the
+        // enclosing team (smithValence runs within a PAR_BLOCK).
+        // elim(row, pivcolumns) eliminates one row, pivcolumns[l]
+        // accumulating the density change of the column of the l-th
+        // entry of the pivot row; one per chunk, merged at the end.
+    template<class BB, class De, class Elim>
+    void ParallelRowElimination(BB& LigneA, const size_t pivrow, const size_t Ni,
+                                const size_t k, De& columns, const Elim& elim) {
+        typedef typename BB::Row Vecteur;
+        const Vecteur& lignepivot = LigneA[pivrow];
+
+        std::vector<size_t> batch;
+        batch.reserve(columns[k]);
+        for(size_t l=pivrow+1; (l<Ni) && (batch.size()<(size_t)columns[k]); ++l)
+            if (LigneA[l].size() && (LigneA[l][0].first == k))
+                batch.push_back(l);
+
+        const size_t nbrows(batch.size()), npiv(lignepivot.size());
+        const size_t nchunks( nbrows < LINBOX_pp_gauss_PARALLEL_THRESHOLD ? 1 :
+                              std::min(nbrows, 4*(size_t)NUM_THREADS) );
+        std::vector<std::vector<long> > pivcolumns(nchunks, std::vector<long>(npiv,0));
+        if (nchunks == 1) {
+            for(size_t i=0; i<nbrows; ++i)
+                elim(LigneA[batch[i]], pivcolumns[0]);
+        } else {
+            SYNCH_GROUP(
+                for(size_t c=0; c<nchunks; ++c) {
+                    const size_t first(c*nbrows/nchunks), last((c+1)*nbrows/nchunks);
+                    { TASK(MODE(VALUE(c,first,last) CONSTREFERENCE(batch,elim) REFERENCE(LigneA,pivcolumns)),
+                    {
+                        for(size_t i=first; i<last; ++i)
+                            elim(LigneA[batch[i]], pivcolumns[c]);
+                    })}
+                }
+            )
+        }
+        for(size_t c=0; c<nchunks; ++c)
+            for(size_t l=0; l<npiv; ++l)
+                columns[ lignepivot[l].first ] += (typename De::value_type)pivcolumns[c][l];
+    }
+
         /** \brief Repository of functions for rank modulo 
          * a prime power by elimination on sparse matrices.
          */
@@ -342,6 +409,19 @@ namespace LinBox
                                const size_t& k,
                                const long& indpermut,
                                De& columns) {
+            PivotColumnDensity<Vecteur,De> pivcolumns(columns, lignepivot);
+            EliminateRow(MOD, lignecourante, lignepivot, invpiv, k, pivcolumns);
+        }
+
+            // Eliminates lignecourante[k] with lignepivot,
+            // pivcolumns[l] is the density of column lignepivot[l].first
+		template<class Modulo, class Vecteur, class PivDe>
+		void EliminateRow( Modulo MOD,
+                           Vecteur& lignecourante,
+                           const Vecteur& lignepivot,
+                           const typename Signed_Trait<Modulo>::unsigned_type& invpiv,
+                           const size_t& k,
+                           PivDe& pivcolumns) {
 
                 //     typedef typename Vecteur::coefficientSpace F;
                 //     typedef typename Vecteur::value_types E;
@@ -369,7 +449,8 @@ namespace LinBox
 					headcoeff *= invpiv;
 					headcoeff %= (UModulo)MOD ;
 					lignecourante[0].second = headcoeff;
-					--columns[ lignecourante[0].first ];
+                        // lignepivot[0].first == k
+					--pivcolumns[ 0 ];
 
 					for(;l<npiv;++l)
 						if (lignepivot[(size_t)l].first > k) break;
@@ -387,16 +468,17 @@ namespace LinBox
                             lignecourante[(size_t)m].second %= (UModulo)MOD;
 							if (isNZero(lignecourante[(size_t)m].second))
 								*ci++ = lignecourante[(size_t)m++];
-							else
-								--columns[ lignecourante[(size_t)m++].first ];
-                                //                         m++;
+							else {
+								--pivcolumns[ l ];
+                                ++m;
+                            }
 						}
 						else {
 							F tmp(headcoeff);
 							tmp *= lignepivot[(size_t)l].second;
 							tmp %= (UModulo)MOD;
 							if (isNZero(tmp)) {
-								++columns[(size_t)j_piv];
+								++pivcolumns[ l ];
 								*ci++ =  E(j_piv, tmp );
 							}
 						}
@@ -411,12 +493,30 @@ namespace LinBox
 			}
 		}
 
+            // Eliminates column k of all the rows below the pivot row,
+            // with tasks of the enclosing team
+		template<class Modulo, class BB, class De>
+		void FaireEliminationParallel( Modulo MOD,
+                                       BB& LigneA,
+                                       const size_t& pivrow,
+                                       const size_t& Ni,
+                                       const typename Signed_Trait<Modulo>::unsigned_type& invpiv,
+                                       const size_t& k,
+                                       De& columns) {
+            typedef typename BB::Row Vecteur;
+            const Vecteur& lignepivot = LigneA[pivrow];
+            ParallelRowElimination(LigneA, pivrow, Ni, k, columns,
+                                   [&](Vecteur& ligne, std::vector<long>& pivcolumns) {
+                                       EliminateRow(MOD, ligne, lignepivot, invpiv, k, pivcolumns);
+                                   });
+        }
+
             // ------------------------------------------------------
             // Rank calculators, defining row strategy
             // ------------------------------------------------------
 
 		template<class Modulo, class BB, class D, class Container, class Perm, bool PrivilegiateNoColumnPivoting, bool PreserveUpperMatrix>
-		void gauss_rankin(Modulo FMOD, Modulo PRIME, Container& ranks, BB& LigneA, Perm& Q, const size_t Ni, const size_t Nj, const D& density_trait)
+		void gauss_rankin(Modulo FMOD, Modulo PRIME, Container& ranks, BB& LigneA, Perm& Q, const size_t Ni, const size_t Nj, const D& density_trait, bool parallel=false)
             {
                 linbox_check( Q.coldim() == Q.rowdim() );
                 linbox_check( Q.coldim() == Nj );
@@ -541,8 +641,11 @@ namespace LinBox
                         UModulo invpiv; 
                         MY_Zpz_inv(invpiv, LigneA[(size_t)k][0].second, PRIME, MOD, exponent);
 
-                        for(size_t l=k + 1; (l < Ni) && (col_density[currentrank]); ++l)
-                            FaireElimination(MOD, LigneA[(size_t)l], LigneA[(size_t)k], invpiv, currentrank, c, col_density);
+                        if (parallel)
+                            FaireEliminationParallel(MOD, LigneA, k, Ni, invpiv, currentrank, col_density);
+                        else
+                            for(size_t l=k + 1; (l < Ni) && (col_density[currentrank]); ++l)
+                                FaireElimination(MOD, LigneA[(size_t)l], LigneA[(size_t)k], invpiv, currentrank, c, col_density);
                     }
                 
 
@@ -591,17 +694,18 @@ namespace LinBox
 		template<class Modulo, class BB, class D, class Container, class Perm>
 		void prime_power_rankin (Modulo FMOD, Modulo PRIME, Container& ranks, BB& SLA, Perm& Q, const size_t Ni, const size_t Nj, const D& density_trait, int StaticParameters=PRIVILEGIATE_NO_COLUMN_PIVOTING)
             {
+                const bool parallel(PARALLEL_ELIMINATION & StaticParameters);
                 if (PRIVILEGIATE_NO_COLUMN_PIVOTING & StaticParameters) {
                     if (PRESERVE_UPPER_MATRIX & StaticParameters) {
-                        gauss_rankin<Modulo,BB,D,Container,Perm,true,true>(FMOD,PRIME,ranks, SLA, Q, Ni, Nj, density_trait);
+                        gauss_rankin<Modulo,BB,D,Container,Perm,true,true>(FMOD,PRIME,ranks, SLA, Q, Ni, Nj, density_trait, parallel);
                     } else {
-                        gauss_rankin<Modulo,BB,D,Container,Perm,true,false>(FMOD,PRIME,ranks, SLA, Q, Ni, Nj, density_trait);
+                        gauss_rankin<Modulo,BB,D,Container,Perm,true,false>(FMOD,PRIME,ranks, SLA, Q, Ni, Nj, density_trait, parallel);
                     }
                 } else {
                     if (PRESERVE_UPPER_MATRIX & StaticParameters) {
-                        gauss_rankin<Modulo,BB,D,Container,Perm,false,true>(FMOD,PRIME,ranks, SLA, Q, Ni, Nj, density_trait);
+                        gauss_rankin<Modulo,BB,D,Container,Perm,false,true>(FMOD,PRIME,ranks, SLA, Q, Ni, Nj, density_trait, parallel);
                     } else {
-                        gauss_rankin<Modulo,BB,D,Container,Perm,false,false>(FMOD,PRIME,ranks, SLA, Q, Ni, Nj, density_trait);
+                        gauss_rankin<Modulo,BB,D,Container,Perm,false,false>(FMOD,PRIME,ranks, SLA, Q, Ni, Nj, density_trait, parallel);
                     }
                 }
             }
@@ -49,6 +49,15 @@
 #  endif
 #endif
 
+// Without PRESERVE_UPPER_MATRIX, over native unsigned integers,
+// the elimination switches to a dense kernel
+// once the density of the active submatrix exceeds this ratio
+#ifndef LINBOX_pp_gauss_DENSE_SWITCH
+#  define LINBOX_pp_gauss_DENSE_SWITCH 0.2
+#endif
+
+#include <type_traits>
+
 
 namespace LinBox
 {
@@ -280,6 +289,37 @@ namespace LinBox
                                const size_t& k,
                                const long& indpermut,
                                De& columns) {
+            PivotColumnDensity<Vecteur,De> pivcolumns(columns, lignepivot);
+            EliminateRow(TWOK, TWOKMONE, lignecourante, lignepivot, invpiv, k, pivcolumns);
+        }
+
+            // Eliminates column k of all the rows below the pivot row,
+            // with tasks of the enclosing team
+        template<class BB, class De>
+        void FaireEliminationParallel( const UInt_t& TWOK, const UInt_t& TWOKMONE,
+                                       BB& LigneA,
+                                       const size_t& pivrow,
+                                       const size_t& Ni,
+                                       const UInt_t& invpiv,
+                                       const size_t& k,
+                                       De& columns) {
+            typedef typename BB::Row Vecteur;
+            const Vecteur& lignepivot = LigneA[pivrow];
+            ParallelRowElimination(LigneA, pivrow, Ni, k, columns,
+                                   [&](Vecteur& ligne, std::vector<long>& pivcolumns) {
+                                       EliminateRow(TWOK, TWOKMONE, ligne, lignepivot, invpiv, k, pivcolumns);
+                                   });
+        }
+
+            // Eliminates lignecourante[k] with lignepivot,
+            // pivcolumns[l] is the density of column lignepivot[l].first
+        template<class Vecteur, class PivDe>
+        void EliminateRow( const UInt_t& TWOK, const UInt_t& TWOKMONE,
+                           Vecteur& lignecourante,
+                           const Vecteur& lignepivot,
+                           const UInt_t& invpiv,
+                           const size_t& k,
+                           PivDe& pivcolumns) {
 
             typedef typename Vecteur::value_type E;
 
@@ -303,7 +343,8 @@ namespace LinBox
                     headcoeff *= invpiv;
                     headcoeff &= TWOKMONE ;
 
-                    --columns[ lignecourante[0].first ];
+                        // lignepivot[0].first == k
+                    --pivcolumns[ 0 ];
 
                     for(;l<npiv;++l)
                         if (lignepivot[(size_t)l].first > k) break;
@@ -326,14 +367,15 @@ namespace LinBox
                             if (isNZero((UInt_t)(lignecourante[(size_t)m].second)))
                                 *ci++ = lignecourante[(size_t)m++];
                             else {
-                                --columns[ lignecourante[(size_t)m++].first ];
+                                --pivcolumns[ l ];
+                                ++m;
 							}
                         } else {
                             UInt_t tmp(headcoeff);
                             tmp *= (UInt_t)lignepivot[(size_t)l].second;
                             tmp &= TWOKMONE;
                             if (isNZero(tmp)) {
-                                ++columns[(size_t)j_piv];
+                                ++pivcolumns[ l ];
                                 *ci++ =  E(j_piv, (UInt_t)tmp );
                             }
                         }
@@ -349,12 +391,155 @@ namespace LinBox
             }
         }
 
+            // ------------------------------------------------------
+            // Dense trailing elimination, native unsigned integers:
+            // wraparound arithmetic is exact modulo 2^EXPONENT
+            // ------------------------------------------------------
+
+            // Density of the active rows [k,Ni) within columns [indcol,Nj)
+        template<class BB>
+        bool DenseSwitch(const BB& LigneA, const size_t k, const size_t Ni,
+                         const size_t indcol, const size_t Nj) const {
+            if ( (k >= Ni) || (indcol >= Nj) ) return false;
+            size_t nnz(0);
+            for(size_t l=k; l<Ni; ++l) nnz += LigneA[l].size();
+            return double(nnz) > LINBOX_pp_gauss_DENSE_SWITCH * double(Ni-k) * double(Nj-indcol);
+        }
+
+            // A[i] <-- (A[i] + h . P[i]) mod 2^e, for i in [0,n)
+            // simple enough to be vectorized by the compiler;
+            // computed at least as wide as unsigned, as narrower types
+            // would be promoted to int and overflow in the product
+        void RowAxpy(UInt_t * A, const UInt_t h, const UInt_t * P,
+                     const size_t n, const UInt_t TWOKMONE) const {
+            typedef typename std::common_type<UInt_t, unsigned>::type Wide_t;
+            for(size_t j=0; j<n; ++j)
+                A[j] = UInt_t( (Wide_t(A[j]) + Wide_t(h)*Wide_t(P[j])) & Wide_t(TWOKMONE) );
+        }
+
+            // Eliminates column r of the rows [first,last) of the
+            // row-major array A, with n columns, by its row r
+        void EliminateDenseRows(UInt_t * A, const size_t n, const size_t r,
+                                const size_t first, const size_t last,
+                                const UInt_t invpiv, const UInt_t TWOK, const UInt_t TWOKMONE) const {
+            typedef typename std::common_type<UInt_t, unsigned>::type Wide_t;
+            const UInt_t * Ar(A+r*n);
+            for(size_t i=first; i<last; ++i) {
+                UInt_t * Ai(A+i*n);
+                if (isNZero(Ai[r])) {
+                        // as in RowAxpy, at least as wide as unsigned
+                    const UInt_t headcoeff = UInt_t( ((Wide_t(TWOK)-Wide_t(Ai[r])) * Wide_t(invpiv)) & Wide_t(TWOKMONE) );
+                    Ai[r] = zero;
+                    RowAxpy(Ai+r+1, headcoeff, Ar+r+1, n-r-1, TWOKMONE);
+                }
+            }
+        }
+
+            // Local ranks of the trailing rows [k,Ni) and columns [indcol,Nj)
+            // copied into a row-major dense array
+        template<class BB, class Container, class Perm>
+        void dense_rankin(uint64_t& EXPONENT, UInt_t& TWOK, UInt_t& TWOKMONE,
+                          Container& ranks, BB& LigneA, Perm& Q,
+                          const size_t k, const size_t Ni,
+                          size_t& indcol, const size_t Nj) {
+            typedef typename BB::Row Vecteur;
+            const size_t col0(indcol);
+            const size_t m(Ni-k), n(Nj-col0);
+
+#ifdef LINBOX_PRANK_OUT
+            std::cerr << "Dense switch at row " << k << ", " << m << 'x' << n << " mod 2^" << EXPONENT << std::endl;
+#endif
+            std::vector<UInt_t> A(m*n, zero);
+            for(size_t i=0; i<m; ++i) {
+                for(auto const & iter : LigneA[k+i])
+                    A[i*n+iter.first-col0] = ((UInt_t)iter.second) & TWOKMONE;
+                LigneA[k+i] = Vecteur(0);
+            }
+
+            for(size_t r=0; (r<m) && (r<n); ) {
+                    // Look for an invertible pivot
+                size_t pi(m), pj(n);
+                bool nonzero(false);
+                for(size_t i=r; (i<m) && (pi==m); ++i) {
+                    const UInt_t * Ai(&A[i*n]);
+                    for(size_t j=r; j<n; ++j) {
+                        nonzero |= isNZero(Ai[j]);
+                        if (isOdd(Ai[j])) { pi=i; pj=j; break; }
+                    }
+                }
+
+                if (pi == m) {
+                    if (! nonzero) break;
+                        // No invertible pivot found
+                        // reduce everything by one power of 2
+                    for(size_t i=r; i<m; ++i)
+                        for(size_t j=r; j<n; ++j)
+                            A[i*n+j] >>= 1;
+                    --EXPONENT;
+                    TWOK >>= 1;
+                    TWOKMONE >>=1;
+                    ranks.push_back( indcol );
+#ifdef LINBOX_PRANK_OUT
+                    std::cerr << "Rank mod 2^" << ranks.size() << " : " << indcol << std::endl;
+#endif
+                    if (TWOK == 1) break;
+                    continue;
+                }
+
+                if (pi != r)
+                    std::swap_ranges(A.begin()+(ptrdiff_t)(pi*n), A.begin()+(ptrdiff_t)(pi*n+n), A.begin()+(ptrdiff_t)(r*n));
+                if (pj != r) {
+                    Q.permute(indcol, col0+pj);
+                    for(size_t i=r; i<m; ++i)
+                        std::swap(A[i*n+r], A[i*n+pj]);
+                }
+
+                UInt_t invpiv;
+                MY_Zpz_inv(invpiv, A[r*n+r], EXPONENT, TWOKMONE);
+
+                    // rows below the pivot, in chunks run as tasks of the
+                    // enclosing team (smithValence runs within a PAR_BLOCK)
+                const size_t nrows(m-r-1);
+                const size_t nchunks( (nrows*(n-r) > (1<<16)) ?
+                                      std::min(nrows, 4*(size_t)NUM_THREADS) : 1 );
+                if (nchunks == 1)
+                    EliminateDenseRows(A.data(), n, r, r+1, m, invpiv, TWOK, TWOKMONE);
+                else {
+                    UInt_t * Ad(A.data());
+                    SYNCH_GROUP(
+                        for(size_t c=0; c<nchunks; ++c) {
+                            const size_t first(r+1+c*nrows/nchunks), last(r+1+(c+1)*nrows/nchunks);
+                            { TASK(MODE(VALUE(Ad,n,r,first,last,invpiv,TWOK,TWOKMONE)),
+                                   { EliminateDenseRows(Ad, n, r, first, last, invpiv, TWOK, TWOKMONE); })}
+                        }
+                    )
+                }
+                ++r; ++indcol;
+            }
+        }
+
+        template<class BB, class Container, class Perm>
+        bool dense_switch(uint64_t& EXPONENT, UInt_t& TWOK, UInt_t& TWOKMONE,
+                          Container& ranks, BB& LigneA, Perm& Q,
+                          const size_t k, const size_t Ni,
+                          size_t& indcol, const size_t Nj, std::true_type) {
+            if (! DenseSwitch(LigneA, k, Ni, indcol, Nj)) return false;
+            dense_rankin(EXPONENT, TWOK, TWOKMONE, ranks, LigneA, Q, k, Ni, indcol, Nj);
+            return true;
+        }
+
+        template<class BB, class Container, class Perm>
+        bool dense_switch(uint64_t&, UInt_t&, UInt_t&, Container&, BB&, Perm&,
+                          const size_t, const size_t, size_t&, const size_t, std::false_type) {
+            return false;
+        }
+
             // ------------------------------------------------------
             // Rank calculators, defining row strategy
             // ------------------------------------------------------
 
         template<class BB, class D, class Container, class Perm, bool PrivilegiateNoColumnPivoting, bool PreserveUpperMatrix>
-        void gauss_rankin(size_t EXPONENTMAX, Container& ranks, BB& LigneA, Perm& Q, const size_t Ni, const size_t Nj, const D& density_trait)
+        void gauss_rankin(size_t EXPONENTMAX, Container& ranks, BB& LigneA, Perm& Q, const size_t Ni, const size_t Nj, const D& density_trait, bool parallel=false)
             {
                 commentator().start ("Gaussian elimination with reordering modulo a prime power of 2",
                                      "PRGEPo2", Ni);
@@ -399,6 +584,7 @@ namespace LinBox
                 size_t ind_pow = 1;
                 size_t maxout = Ni/100; maxout = (maxout<10 ? 10 : (maxout>1000 ? 1000 : maxout) );
                 size_t thres = Ni/maxout; thres = (thres >0 ? thres : 1);
+                bool densified(false);
 
 
                 for (size_t k=0; k<last;++k) {
@@ -478,8 +664,11 @@ namespace LinBox
                             // Compute the inverse of the found pivot
                         UInt_t invpiv;
                         MY_Zpz_inv(invpiv, (UInt_t) (LigneA[(size_t)k][0].second), EXPONENT, TWOKMONE);
-                        for(size_t l=k + 1; (l < Ni) && (col_density[currentrank]); ++l)
-                            FaireElimination(EXPONENT, TWOK, TWOKMONE, LigneA[(size_t)l], LigneA[(size_t)k], invpiv, currentrank, c, col_density);
+                        if (parallel)
+                            FaireEliminationParallel(TWOK, TWOKMONE, LigneA, k, Ni, invpiv, currentrank, col_density);
+                        else
+                            for(size_t l=k + 1; (l < Ni) && (col_density[currentrank]); ++l)
+                                FaireElimination(EXPONENT, TWOK, TWOKMONE, LigneA[(size_t)l], LigneA[(size_t)k], invpiv, currentrank, c, col_density);
                     }
                     
 #ifdef  LINBOX_pp_gauss_steps_OUT
@@ -490,26 +679,35 @@ namespace LinBox
 #endif
 
                     PreserveUpperMatrixRow(LigneA[(size_t)k], typename Boolean_Trait<PreserveUpperMatrix>::BooleanType());
-                }
 
-                c = -2;
-                SameColumnPivoting(LigneA[(size_t)last], indcol, c, col_density, typename Boolean_Trait<PrivilegiateNoColumnPivoting>::BooleanType() );
-                if (c == -2) CherchePivot( LigneA[(size_t)last], indcol, c, col_density );
-                while( c == -2) {
-                    ranks.push_back( indcol );
-                    for(long jjj=(long)LigneA[(size_t)last].size();jjj--;)
-                        LigneA[(size_t)last][(size_t)jjj].second >>= 1;
-                    TWOK >>= 1;
-                    CherchePivot( LigneA[(size_t)last], indcol, c, col_density );
+                    if ( (! PreserveUpperMatrix) && (! (k % thres)) &&
+                         dense_switch(EXPONENT, TWOK, TWOKMONE, ranks, LigneA, Q, k+1, Ni, indcol, Nj,
+                                      std::integral_constant<bool,std::is_integral<UInt_t>::value && std::is_unsigned<UInt_t>::value>()) ) {
+                        densified = true;
+                        break;
+                    }
                 }
-                if (c != -1) {
-                    const size_t currentrank(indcol-1);
-                    if (c != (long)currentrank) {
+
+                if (! densified) {
+                    c = -2;
+                    SameColumnPivoting(LigneA[(size_t)last], indcol, c, col_density, typename Boolean_Trait<PrivilegiateNoColumnPivoting>::BooleanType() );
+                    if (c == -2) CherchePivot( LigneA[(size_t)last], indcol, c, col_density );
+                    while( c == -2) {
+                        ranks.push_back( indcol );
+                        for(long jjj=(long)LigneA[(size_t)last].size();jjj--;)
+                            LigneA[(size_t)last][(size_t)jjj].second >>= 1;
+                        TWOK >>= 1;
+                        CherchePivot( LigneA[(size_t)last], indcol, c, col_density );
+                    }
+                    if (c != -1) {
+                        const size_t currentrank(indcol-1);
+                        if (c != (long)currentrank) {
 #ifdef  LINBOX_pp_gauss_steps_OUT
-                        std::cerr << "------------ permuting cols " << (indcol-1) << " and " << c << " ---" << std::endl;
+                            std::cerr << "------------ permuting cols " << (indcol-1) << " and " << c << " ---" << std::endl;
 #endif
-                        Q.permute(currentrank,c);
-						PermuteUpperMatrix(LigneA, last, currentrank, c, typename Boolean_Trait<PreserveUpperMatrix>::BooleanType());
+                            Q.permute(currentrank,c);
+                            PermuteUpperMatrix(LigneA, last, currentrank, c, typename Boolean_Trait<PreserveUpperMatrix>::BooleanType());
+                        }
                     }
                 }
                 while( TWOK > 1) {
@@ -532,17 +730,18 @@ namespace LinBox
 
         template<class BB, class D, class Container, class Perm>
         void prime_power_rankin (size_t EXPONENT, Container& ranks, BB& SLA, Perm& Q, const size_t Ni, const size_t Nj, const D& density_trait, int StaticParameters=PRIVILEGIATE_NO_COLUMN_PIVOTING) {
+            const bool parallel(PARALLEL_ELIMINATION & StaticParameters);
             if (PRIVILEGIATE_NO_COLUMN_PIVOTING & StaticParameters) {
                 if (PRESERVE_UPPER_MATRIX & StaticParameters) {
-                    gauss_rankin<BB,D,Container,Perm,true,true>(EXPONENT,ranks, SLA, Q, Ni, Nj, density_trait);
+                    gauss_rankin<BB,D,Container,Perm,true,true>(EXPONENT,ranks, SLA, Q, Ni, Nj, density_trait, parallel);
                 } else {
-                    gauss_rankin<BB,D,Container,Perm,true,false>(EXPONENT,ranks, SLA, Q, Ni, Nj, density_trait);
+                    gauss_rankin<BB,D,Container,Perm,true,false>(EXPONENT,ranks, SLA, Q, Ni, Nj, density_trait, parallel);
                 }
             } else {
                 if (PRESERVE_UPPER_MATRIX & StaticParameters) {
-                    gauss_rankin<BB,D,Container,Perm,false,true>(EXPONENT,ranks, SLA, Q, Ni, Nj, density_trait);
+                    gauss_rankin<BB,D,Container,Perm,false,true>(EXPONENT,ranks, SLA, Q, Ni, Nj, density_trait, parallel);
                 } else {
-                    gauss_rankin<BB,D,Container,Perm,false,false>(EXPONENT,ranks, SLA, Q, Ni, Nj, density_trait);
+                    gauss_rankin<BB,D,Container,Perm,false,false>(EXPONENT,ranks, SLA, Q, Ni, Nj, density_trait, parallel);
                 }
             }
         }
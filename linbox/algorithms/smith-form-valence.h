@@ -194,7 +194,7 @@ std::vector<size_t>& PRank(std::vector<size_t>& ranks, size_t& effective_exponen
         Permutation<Ring> Q(F,A.coldim());
 
 		Timer tim; tim.clear(); tim.start();
-		PGD.prime_power_rankin( lq, lp, ranks, A, Q, A.rowdim(), A.coldim(), std::vector<size_t>());
+		PGD.prime_power_rankin( lq, lp, ranks, A, Q, A.rowdim(), A.coldim(), std::vector<size_t>(), PRIVILEGIATE_NO_COLUMN_PIVOTING | PARALLEL_ELIMINATION);
 		tim.stop();
 #if __VALENCE_REPORTING__
 		{
@@ -252,7 +252,7 @@ std::vector<size_t>& PRankPowerOfTwo(std::vector<size_t>& ranks, size_t& effecti
     Permutation<GF2> Q(F2,A.coldim());
 
 	Timer tim; tim.clear(); tim.start();
-	PGD.prime_power_rankin( effective_exponent, ranks, A, Q, A.rowdim(), A.coldim(), std::vector<size_t>());
+	PGD.prime_power_rankin( effective_exponent, ranks, A, Q, A.rowdim(), A.coldim(), std::vector<size_t>(), PRIVILEGIATE_NO_COLUMN_PIVOTING | PARALLEL_ELIMINATION);
 	tim.stop();
 #if __VALENCE_REPORTING__
 	{
@@ -278,7 +278,7 @@ std::vector<size_t>& PRankInteger(std::vector<size_t>& ranks, const char * filen
     Permutation<Ring> Q(F,A.coldim());
 
 	Timer tim; tim.clear(); tim.start();
-	PGD.prime_power_rankin( q, p, ranks, A, Q, A.rowdim(), A.coldim(), std::vector<size_t>());
+	PGD.prime_power_rankin( q, p, ranks, A, Q, A.rowdim(), A.coldim(), std::vector<size_t>(), PRIVILEGIATE_NO_COLUMN_PIVOTING | PARALLEL_ELIMINATION);
 	tim.stop();
 	if (__VALENCE_REPORTING__) {
         std::ostringstream logreport;
@@ -302,7 +302,7 @@ std::vector<size_t>& PRankIntegerPowerOfTwo(std::vector<size_t>& ranks, const ch
     Permutation<Ring> Q(ZZ, A.coldim());
 
 	Timer tim; tim.clear(); tim.start();
-	PGD.prime_power_rankin( e, ranks, A, Q, A.rowdim(), A.coldim(), std::vector<size_t>());
+	PGD.prime_power_rankin( e, ranks, A, Q, A.rowdim(), A.coldim(), std::vector<size_t>(), PRIVILEGIATE_NO_COLUMN_PIVOTING | PARALLEL_ELIMINATION);
 	tim.stop();
 	if (__VALENCE_REPORTING__) {
         std::ostringstream logreport;
@@ -466,16 +466,29 @@ std::vector<Givaro::Integer>& smithValence(std::vector<Givaro::Integer>& SmithDi
 
     WAIT;
 
-    SYNCH_GROUP(
-        for(size_t j=0; j<Moduli.size(); ++j) {
-            { TASK(MODE(CONSTREFERENCE(smith,Moduli,AllRanks,filename,coprimeR,exponents)
-                        WRITE(AllRanks[j])),
-            {
-                AllPowersRanks(AllRanks[j], Moduli[j], smith[j], exponents[j],
-                               coprimeR, filename.c_str());
-            })}
-        }
-    )
+        // Primes whose powers have to be eliminated
+    std::vector<size_t> nonLocal;
+    for(size_t j=0; j<Moduli.size(); ++j)
+        if (smith[j] != coprimeR) nonLocal.push_back(j);
+
+    if (nonLocal.size() == 1) {
+            // A single prime: eliminated here, the tasks of its
+            // parallel elimination are shared by the whole team
+        const size_t j(nonLocal.front());
+        AllPowersRanks(AllRanks[j], Moduli[j], smith[j], exponents[j],
+                       coprimeR, filename.c_str());
+    } else {
+        SYNCH_GROUP(
+            for(size_t j=0; j<Moduli.size(); ++j) {
+                { TASK(MODE(CONSTREFERENCE(smith,Moduli,AllRanks,filename,coprimeR,exponents)
+                            WRITE(AllRanks[j])),
+                {
+                    AllPowersRanks(AllRanks[j], Moduli[j], smith[j], exponents[j],
+                                   coprimeR, filename.c_str());
+                })}
+            }
+        )
+    }
 
     for(size_t j=0; j<Moduli.size(); ++j) {
         if (smith[j] != coprimeR) {
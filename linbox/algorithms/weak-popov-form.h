@@ -32,7 +32,20 @@
 #include <utility>
 #include <vector>
 
+#include "linbox/integer.h"
+#include "linbox/util/error.h"
 #include "linbox/matrix/dense-matrix.h"
+#include "linbox/ring/modular.h"
+#include "linbox/ring/polynomial-ring.h"
+#include "linbox/matrix/polynomial-matrix.h"
+#include "linbox/algorithms/polynomial-matrix/popov-form.h"
+#include "linbox/algorithms/poly-det.h"
+
+// solveDet takes the weak Popov form of a m x m matrix of degree d
+// while m <= LINBOX_WEAK_POPOV_DET_RATIO * d, the elimination otherwise
+#if !defined(LINBOX_WEAK_POPOV_DET_RATIO)
+#define LINBOX_WEAK_POPOV_DET_RATIO 1
+#endif
 
 namespace LinBox
 {
@@ -274,13 +287,179 @@ namespace LinBox
 			solveDetHelper(det, SubT);
 		}
 
+		/**
+		 * Ordered weak Popov form W = U M of a square nonsingular M, with
+		 * order bases and polynomial matrix products over a word size prime
+		 * field (see PolynomialMatrixPopovDomain).
+		 * returns false, W being untouched, if the characteristic does not fit.
+		 */
+		template<typename Matrix>
+		bool fastWeakPopov(Matrix &W, const Matrix &M) const {
+			typedef PolynomialMatrixPopovDomain<FastField> PopovDomain;
+			typedef typename PopovDomain::MatrixP FastMatrix;
+
+			integer p;
+			_R.getCoeffField().characteristic(p);
+			if (p < 2 || p > integer(FastField::maxCardinality())) {
+				return false;
+			}
+
+			FastField F(p);
+			FastMatrix A(F, M.rowdim(), M.coldim(), maxDegree(M) + 1);
+			toFast(A, M);
+
+			PopovDomain PD(F);
+			FastMatrix B(F, M.rowdim(), M.coldim(), 1);
+			PD.weakPopov(B, A);
+
+			fromFast(W, B);
+			return true;
+		}
+
 		template<typename Matrix>
 		void solveDet(Polynomial &det, const Matrix &T_in) const {
+			if (solveDetFast(det, T_in)) {
+				return;
+			}
+
 			DenseMatrix<typename Matrix::Field> T(T_in);
 			_R.assign(det, _R.one);
 
 			solveDetHelper(det, T);
 		}
+
+	private:
+		typedef Givaro::Modular<double> FastField;
+
+		/**
+		 * det(M) up to a constant: the weak Popov form gives the exact degree
+		 * of the determinant, which is then interpolated over the same field,
+		 * and a singular M gives 0.
+		 * The row reduction costs O~(m^(omega+1) d) for M m x m of degree d,
+		 * so it is only taken while m <= LINBOX_WEAK_POPOV_DET_RATIO * d.
+		 * returns false if the field is too large or has too few points,
+		 * or if M is too large for its degree.
+		 */
+		template<typename Matrix>
+		bool solveDetFast(Polynomial &det, const Matrix &M) const {
+			typedef PolynomialMatrixPopovDomain<FastField> PopovDomain;
+			typedef typename PopovDomain::MatrixP FastMatrix;
+			typedef LinBox::PolynomialRing<FastField, Givaro::Dense> FastRing;
+
+			integer p;
+			_R.getCoeffField().characteristic(p);
+			if (M.rowdim() != M.coldim() || p < 2 || p > integer(FastField::maxCardinality())) {
+				return false;
+			}
+			const size_t d = maxDegree(M);
+			if (double(M.rowdim()) > LINBOX_WEAK_POPOV_DET_RATIO * double(d)) {
+				return false;
+			}
+
+			FastField F(p);
+			FastMatrix A(F, M.rowdim(), M.coldim(), d + 1);
+			toFast(A, M);
+
+			PopovDomain PD(F);
+			FastMatrix B(F, M.rowdim(), M.coldim(), 1);
+			std::vector<size_t> rdeg;
+			try {
+				rdeg = PD.weakPopov(B, A);
+			} catch (LinboxMathSingularMatrix&) {
+				_R.assign(det, _R.zero);
+				return true;
+			}
+
+			size_t bound = 0;
+			for (size_t i = 0; i < rdeg.size(); i++) {
+				bound += rdeg[i];
+			}
+			const size_t npts = roundUpPowerOfTwo((unsigned int)(bound + 1));
+			if (p < integer((uint64_t)npts)) {
+				return false;
+			}
+
+			FastRing FR(F);
+			DenseMatrix<FastRing> C(FR, M.rowdim(), M.coldim());
+			for (size_t i = 0; i < M.rowdim(); i++) {
+				for (size_t j = 0; j < M.coldim(); j++) {
+					typename FastRing::Element f(F, B.size());
+					for (size_t k = 0; k < B.size(); k++) {
+						F.assign(f[k], B.get(i, j, k));
+					}
+					FR.setdegree(f);
+					C.setEntry(i, j, f);
+				}
+			}
+
+			// the degree is exact: all the points, no early termination
+			typedef typename FastRing::Parent_t FastPolyDom;
+			PolyDetDomain<FastField, FastPolyDom> PDD(F, FR);
+			typename FastPolyDom::Element fd;
+			PDD.det(fd, C, npts, 0);
+
+			_R.init(det);
+			for (size_t k = 0; k < fd.size(); k++) {
+				integer tmp;
+				Coeff c;
+				F.convert(tmp, fd[k]);
+				_R.getCoeffField().init(c, tmp);
+				_R.setCoeff(det, k, c);
+			}
+			return true;
+		}
+
+		template<typename Matrix>
+		size_t maxDegree(const Matrix &M) const {
+			size_t d = 0;
+			for (size_t i = 0; i < M.rowdim(); i++) {
+				for (size_t j = 0; j < M.coldim(); j++) {
+					d = std::max(d, _R.deg(M.getEntry(i, j)));
+				}
+			}
+			return d;
+		}
+
+		template<typename FastMatrix, typename Matrix>
+		void toFast(FastMatrix &A, const Matrix &M) const {
+			const FastField &F = A.field();
+			for (size_t i = 0; i < M.rowdim(); i++) {
+				for (size_t j = 0; j < M.coldim(); j++) {
+					Polynomial f;
+					M.getEntry(f, i, j);
+					if (_R.isZero(f)) {
+						continue;
+					}
+
+					for (size_t k = 0; k <= _R.deg(f); k++) {
+						integer tmp;
+						Coeff c;
+						_R.getCoeff(c, f, k);
+						_R.getCoeffField().convert(tmp, c);
+						F.init(A.ref(i, j, k), tmp);
+					}
+				}
+			}
+		}
+
+		template<typename Matrix, typename FastMatrix>
+		void fromFast(Matrix &W, const FastMatrix &B) const {
+			const FastField &F = B.field();
+			for (size_t i = 0; i < B.rowdim(); i++) {
+				for (size_t j = 0; j < B.coldim(); j++) {
+					Polynomial f;
+					_R.init(f);
+					for (size_t k = 0; k < B.size(); k++) {
+						integer tmp;
+						Coeff c;
+						F.convert(tmp, B.get(i, j, k));
+						_R.getCoeffField().init(c, tmp);
+						_R.setCoeff(f, k, c);
+					}
+					W.setEntry(i, j, f);
+				}
+			}
+		}
 	}; // end of class WeakPopovFormDomain
 }
 
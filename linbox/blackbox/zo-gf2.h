@@ -28,7 +28,10 @@
 #define __LINBOX_zo_gf2_H
 
 #include <algorithm>
+#include <cstdint>
+#include <vector>
 #include "linbox/blackbox/zero-one.h"
+#include "linbox/blackbox/blockbb.h"
 #include "linbox/field/gf2.h"
 #include <givaro/zring.h>
 #include "linbox/util/matrix-stream.h"
@@ -112,6 +115,30 @@ namespace LinBox
 		template<class OutVector, class InVector>
 		OutVector& applyTranspose(OutVector& y, const InVector& x) const; // y = A^T x
 
+		/** Word-parallel block apply, Y = A X.
+		 * X is a coldim() x w block of bits stored one word per row,
+		 * Y is rowdim() x w, so that each non-zero XORs a whole word:
+		 * w = 64 with uint64_t, wider with a vector extension type
+		 * (any Word with ^= and value initialization).
+		 */
+		template<class Word>
+		std::vector<Word>& applyLeft(std::vector<Word>& Y, const std::vector<Word>& X) const;
+
+		/** Word-parallel block apply, Y = X A.
+		 * X is a w x rowdim() block of bits stored one word per column,
+		 * Y is w x coldim(), that is Y = A^T X in the word representation.
+		 */
+		template<class Word>
+		std::vector<Word>& applyRight(std::vector<Word>& Y, const std::vector<Word>& X) const;
+
+		/// Block apply Y = A X on dense matrices, 64 columns at a time.
+		template<class Matrix>
+		Matrix& applyLeft(Matrix& Y, const Matrix& X) const;
+
+		/// Block apply Y = X A on dense matrices, 64 rows at a time.
+		template<class Matrix>
+		Matrix& applyRight(Matrix& Y, const Matrix& X) const;
+
 		/** Read the matrix from a stream in ANY format
 		 *  entries are read as "long int" and set to 1 if they are odd,
 		 *  0 otherwise
@@ -162,6 +189,11 @@ namespace LinBox
 		size_t _rowdim, _coldim, _nnz;
 	};
 
+	template<>
+	struct is_blockbb<ZeroOne<GF2> > {
+		static const bool value = true;
+	};
+
 }
 
 #include "linbox/blackbox/zo-gf2.inl"
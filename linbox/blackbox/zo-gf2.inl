@@ -30,6 +30,9 @@
 #define __LINBOX_zo_gf2_INL
 
 #include <givaro/givintfactor.h>
+#ifdef __LINBOX_USE_OPENMP
+#include <omp.h>
+#endif
 
 namespace LinBox
 {
@@ -92,6 +95,90 @@ namespace LinBox
 		return y;
 	}
 
+	template<class Word>
+	inline std::vector<Word> & ZeroOne<GF2>::applyLeft(std::vector<Word> & Y, const std::vector<Word> & X) const
+	{
+		linbox_check(X.size() >= coldim());
+		Y.resize(rowdim());
+		const long lm((long)rowdim());
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(dynamic,256) if (_nnz > (1<<16))
+#endif
+		for(long i=0; i<lm; ++i) {
+			const Row_t& row = this->operator[]((size_t)i);
+			Word tmp = Word();
+			for(Row_t::const_iterator loc = row.begin(); loc != row.end(); ++loc)
+				tmp ^= X[*loc];
+			Y[(size_t)i] = tmp;
+		}
+		return Y;
+	}
+
+	template<class Word>
+	inline std::vector<Word> & ZeroOne<GF2>::applyRight(std::vector<Word> & Y, const std::vector<Word> & X) const
+	{
+		linbox_check(X.size() >= rowdim());
+		Y.assign(coldim(), Word());
+		typename std::vector<Word>::const_iterator xit = X.begin();
+		Self_t::const_iterator row = this->begin();
+		for( ; row != this->end(); ++row, ++xit) {
+			const Word xi = *xit;
+			for(Row_t::const_iterator loc = row->begin(); loc != row->end(); ++loc)
+				Y[*loc] ^= xi;
+		}
+		return Y;
+	}
+
+	template<class Matrix>
+	inline Matrix & ZeroOne<GF2>::applyLeft(Matrix & Y, const Matrix & X) const
+	{
+		linbox_check(X.rowdim() == coldim());
+		linbox_check(Y.rowdim() == rowdim());
+		linbox_check(Y.coldim() == X.coldim());
+		std::vector<uint64_t> Xw(coldim()), Yw(rowdim());
+		typename Matrix::Element e;
+		for(size_t c0=0; c0 < X.coldim(); c0 += 64) {
+			const size_t w = std::min(X.coldim()-c0, size_t(64));
+			for(size_t j=0; j<coldim(); ++j) {
+				uint64_t word(0);
+				for(size_t b=0; b<w; ++b)
+					if (! X.field().isZero(X.getEntry(e, j, c0+b)) )
+						word |= uint64_t(1) << b;
+				Xw[j] = word;
+			}
+			applyLeft(Yw, Xw);
+			for(size_t i=0; i<rowdim(); ++i)
+				for(size_t b=0; b<w; ++b)
+					Y.setEntry(i, c0+b, (Yw[i] >> b) & 1 ? Y.field().one : Y.field().zero);
+		}
+		return Y;
+	}
+
+	template<class Matrix>
+	inline Matrix & ZeroOne<GF2>::applyRight(Matrix & Y, const Matrix & X) const
+	{
+		linbox_check(X.coldim() == rowdim());
+		linbox_check(Y.coldim() == coldim());
+		linbox_check(Y.rowdim() == X.rowdim());
+		std::vector<uint64_t> Xw(rowdim()), Yw(coldim());
+		typename Matrix::Element e;
+		for(size_t r0=0; r0 < X.rowdim(); r0 += 64) {
+			const size_t w = std::min(X.rowdim()-r0, size_t(64));
+			for(size_t i=0; i<rowdim(); ++i) {
+				uint64_t word(0);
+				for(size_t b=0; b<w; ++b)
+					if (! X.field().isZero(X.getEntry(e, r0+b, i)) )
+						word |= uint64_t(1) << b;
+				Xw[i] = word;
+			}
+			applyRight(Yw, Xw);
+			for(size_t j=0; j<coldim(); ++j)
+				for(size_t b=0; b<w; ++b)
+					Y.setEntry(r0+b, j, (Yw[j] >> b) & 1 ? Y.field().one : Y.field().zero);
+		}
+		return Y;
+	}
+
 
 	inline const ZeroOne<GF2>::Element& ZeroOne<GF2>::setEntry(size_t i, size_t j, const Element& v) {
 		Row_t& rowi = this->operator[](i);
@@ -38,94 +38,153 @@
 #ifndef __LINBOX_blas_matrix_multimod_H
 #define __LINBOX_blas_matrix_multimod_H
 
-#include "linbox/util/debug.h"
-
-// #include "linbox/vector/subiterator.h"
-// #include "linbox/vector/subvector.h"
+#include <vector>
+#include <algorithm>
+#include <fflas-ffpack/fflas/fflas.h>
+#include <fflas-ffpack/field/rns-double.h>
 
+#include "linbox/util/debug.h"
+#include "linbox/integer.h"
+#include "linbox/field/multimod-field.h"
 #include "linbox/matrix/matrix-category.h"
 #include "linbox/linbox-tags.h"
 #include "linbox/matrix/dense-matrix.h"
 
-THIS_CODE_MAY_NOT_COMPILE_AND_IS_NOT_TESTED
-
 namespace LinBox
 { /*  Specialisation of BlasMatrix for MultiModDouble field */
 
-	/*! No Doc.
-	*/
-	template<>
-	class BlasMatrix<MultiModDouble> {
+	/*! Dense matrix over a MultiModDouble.
+	 * The matrix is stored as \c k residue planes, one per modulus of the
+	 * field, in a single array: plane \c l is the row major \c m x \c n
+	 * matrix modulo <code>F.getBase(l)</code>, starting at
+	 * <code>getPointer(l) = getPointer() + l*m*n</code>, with stride \c n.
+	 * Each plane can thus be given directly to FFLAS/FFPACK, and the
+	 * whole array is the layout used by FFPACK::rns_double for the
+	 * reduction of an integer matrix.
+	 *
+	 * An entry is the \c std::vector<double> of its residues.
+	 * The storage parameter is only there so that rebinding any
+	 * \c BlasMatrix to MultiModDouble lands here.
+	 */
+	template<class _Storage>
+	class BlasMatrix<MultiModDouble,_Storage> {
 
 	public:
 
-		typedef MultiModDouble         Field;
-		typedef std::vector<double>  Element;
-		typedef BlasMatrix<MultiModDouble> Self_t;
+		typedef MultiModDouble                 Field;
+		typedef std::vector<double>          Element;
+		typedef BlasMatrix<MultiModDouble,_Storage> Self_t;
+		typedef Givaro::Modular<double>     BaseField;
 
 	protected:
 
 		MultiModDouble                 _field;
-		const std::vector<MatrixDomain<Givaro::Modular<double> > >   _MD;
 		size_t                  _row,_col;
-		Element                _One,_Zero; //! @warning used ?
-		std::vector<BlasMatrix<Givaro::Modular<double> >* > _rep;
-		mutable std::vector<double>       _entry;
-	public:
+		std::vector<double>            _rep;
+		mutable Element              _entry;
 
-
-		//BlasMatrix () {}
+	public:
 
 		BlasMatrix (const MultiModDouble& F) :
-			_field(F) , _rep(F.size()), _entry(F.size())
+			_field(F), _row(0), _col(0), _entry(F.size())
 		{}
 
-		BlasMatrix (const Field& F, size_t m, size_t n, bool alloc=true) :
-			_field(F), _row(m) , _col(n) , _rep(F.size()),  _entry(F.size())
+		BlasMatrix (const Field& F, size_t m, size_t n) :
+			_field(F), _row(m) , _col(n) , _rep(F.size()*m*n, 0.), _entry(F.size())
+		{}
+
+		//! Reduction of any matrix with \c getEntry modulo all the primes of \p F.
+		template<class Matrix>
+		BlasMatrix (const Matrix& A, const MultiModDouble& F) :
+			_field(F), _row(0), _col(0), _entry(F.size())
 		{
-			for (size_t i=0;i<_rep.size();++i)
-				_rep[i] =  new BlasMatrix<Givaro::Modular<double> > (F.getBase(i), m, n);
+			copy(A);
 		}
 
-		BlasMatrix (const BlasMatrix<MultiModDouble> & A):
+		BlasMatrix (const Self_t & A):
 			_field(A._field),_row(A._row), _col(A._col),
-			_rep(A._rep.size()), _entry(A._entry)
-		{
+			_rep(A._rep), _entry(A._entry)
+		{}
 
-			for (size_t i=0;i<_rep.size();++i)
-				_rep[i]= new  BlasMatrix<Givaro::Modular<double> > (const_cast<BlasMatrix<Givaro::Modular<double> >& >( *A._rep[i]));
+		Self_t& operator=(const Self_t & A)
+		{
+			_field = A._field;
+			_row   = A._row;
+			_col   = A._col;
+			_rep   = A._rep;
+			_entry = A._entry;
+			return *this;
 		}
 
+		//! Resize to \p m x \p n, the content is lost.
+		void resize (size_t m, size_t n)
+		{
+			_row = m; _col = n;
+			_rep.assign(_field.size()*m*n, 0.);
+		}
 
-		const BlasMatrix<MultiModDouble>& operator=(const BlasMatrix<MultiModDouble> & A)
+		/*! Reduce \p A modulo all the primes.
+		 * Integer blas matrices are reduced all at once by a multimodular
+		 * reduction written as a product of word size matrices
+		 * (FFPACK::rns_double), other matrices entry by entry.
+		 */
+		template<class Matrix>
+		Self_t& copy (const Matrix& A)
 		{
-			_field   = A._field;
-			_row = A._row;
-			_col = A._col;
-			_rep = std::vector<BlasMatrix<Givaro::Modular<double> >* >(A._rep.size());
-			_entry = A._entry;
-			for (size_t i=0;i<_rep.size();++i)
-				_rep[i]= new  BlasMatrix<Givaro::Modular<double> > (const_cast<BlasMatrix<Givaro::Modular<double> >& >( *A._rep[i]));
+			resize(A.rowdim(), A.coldim());
+			typename Matrix::Field::Element e;
+			integer x;
+			for (size_t i = 0; i < _row; ++i)
+				for (size_t j = 0; j < _col; ++j) {
+					A.field().convert(x, A.getEntry(e, i, j));
+					for (size_t l = 0; l < size(); ++l)
+						_field.getBase(l).init(_rep[(l*_row+i)*_col+j], x);
+				}
 			return *this;
 		}
 
-
-		~BlasMatrix() {for (size_t i=0; i< _rep.size();++i) {delete _rep[i];} }
+		template<class _Rep>
+		Self_t& copy (const BlasMatrix<Givaro::ZRing<Integer>,_Rep>& A)
+		{
+			resize(A.rowdim(), A.coldim());
+			if (_rep.empty()) return *this;
+			integer maxA(0);
+			for (size_t i = 0; i < _row; ++i)
+				for (size_t j = 0; j < _col; ++j) {
+					const integer& a = A.getEntry(i, j);
+					if (a > maxA) maxA = a;
+					else if (-a > maxA) maxA = -a;
+				}
+			if (maxA.bitsize() > _field.getCRTmodulo().bitsize()) {
+				// more 16 bits chunks than rns_double is set up for
+				for (size_t i = 0; i < _row; ++i)
+					for (size_t j = 0; j < _col; ++j)
+						for (size_t l = 0; l < size(); ++l)
+							_field.getBase(l).init(_rep[(l*_row+i)*_col+j], A.getEntry(i, j));
+				return *this;
+			}
+			std::vector<double> basis(size());
+			for (size_t l = 0; l < size(); ++l)
+				basis[l] = _field.getModulo(l);
+			FFPACK::rns_double RNS(basis);
+			RNS.init(_row, _col, getPointer(), _row*_col, A.getPointer(), A.getStride(), maxA);
+			return *this;
+		}
 
 		template <class Vector1, class Vector2>
 		Vector1&  apply (Vector1& y, const Vector2& x) const
 		{
-			for (size_t i=0;i<_rep.size();++i) {
-				std::vector<double> x_tmp(x.size()), y_tmp(y.size());
+			std::vector<double> x_tmp(x.size()), y_tmp(y.size());
+			for (size_t l=0;l<size();++l) {
 				for (size_t j=0;j<x.size();++j)
-					x_tmp[j]= x[j][i];
-
-				_rep[i]->apply(y_tmp, x_tmp);
+					x_tmp[j]= x[j][l];
 
-				for (size_t j=0;j<y.size();++j){
-					y[j][i]=y_tmp[j];
+				FFLAS::fgemv(_field.getBase(l), FFLAS::FflasNoTrans, _row, _col,
+					     _field.getBase(l).one, getPointer(l), getStride(), x_tmp.data(), 1,
+					     _field.getBase(l).zero, y_tmp.data(), 1);
 
-				}
+				for (size_t j=0;j<y.size();++j)
+					y[j][l]=y_tmp[j];
 			}
 
 			return y;
@@ -134,79 +193,86 @@ namespace LinBox
 		template <class Vector1, class Vector2>
 		Vector1&  applyTranspose (Vector1& y, const Vector2& x) const
 		{
-			for (size_t i=0;i<_rep.size();++i) {
-				std::vector<double> x_tmp(x.size()), y_tmp(y.size());
+			std::vector<double> x_tmp(x.size()), y_tmp(y.size());
+			for (size_t l=0;l<size();++l) {
 				for (size_t j=0;j<x.size();++j)
-					x_tmp[i]= x[j][i];
+					x_tmp[j]= x[j][l];
 
-				_rep[i]->applyTranspose(y_tmp, x_tmp);
+				FFLAS::fgemv(_field.getBase(l), FFLAS::FflasTrans, _row, _col,
+					     _field.getBase(l).one, getPointer(l), getStride(), x_tmp.data(), 1,
+					     _field.getBase(l).zero, y_tmp.data(), 1);
 
 				for (size_t j=0;j<y.size();++j)
-					y[j][i]=y_tmp[i];
+					y[j][l]=y_tmp[j];
 			}
 
 			return y;
 		}
 
-#if 0
-		template<typename _Tp1>
-		struct rebind
-		{
-			typedef BlasMatrix<_Tp1> other;
-
-			void operator() (other *& Ap, const Self_t& A, const _Tp1& F) {
-				Ap = new other(F, A.rowdim(), A.coldim());
-				Hom<Field, _Tp1> hom(A. field(), F);
-
-				hom.image (*Ap_p, *A_p);
-			}
-		};
-#endif
-
 		size_t rowdim() const {return _row;}
 
 		size_t coldim() const {return _col;}
 
+		//! Number of residue planes.
+		size_t size() const {return _field.size();}
 
 		const Field &field() const  {return _field;}
 
+		//! Start of the residue planes.
+		double* getPointer() {return _rep.data();}
+		const double* getPointer() const {return _rep.data();}
+
+		//! Start of the plane modulo <code>field().getBase(l)</code>.
+		double* getPointer(size_t l) {return _rep.data()+l*_row*_col;}
+		const double* getPointer(size_t l) const {return _rep.data()+l*_row*_col;}
+
+		//! Row stride of each plane.
+		size_t getStride() const {return _col;}
 
 		std::ostream& write(std::ostream& os) const
 		{
-			for (size_t i=0;i<_rep.size();++i)
-				_rep[i]->write(os);
+			for (size_t l=0;l<size();++l) {
+				os << "modulo " << integer(_field.getModulo(l)) << std::endl;
+				for (size_t i=0;i<_row;++i) {
+					for (size_t j=0;j<_col;++j)
+						os << getPointer(l)[i*_col+j] << ' ';
+					os << std::endl;
+				}
+			}
 			return os;
 		}
 
-
-		const Element& setEntry (size_t , size_t j, const Element &a_ij)
+		const Element& setEntry (size_t i, size_t j, const Element &a_ij)
 		{
-			for (size_t i=0; i< _rep.size();++i)
-				_rep[i]->setEntry(i,j,a_ij[i]);
-            return a_ij;
+			for (size_t l=0; l< size();++l)
+				_rep[(l*_row+i)*_col+j] = a_ij[l];
+			return a_ij;
 		}
 
-
-		const Element& getEntry (size_t , size_t j) const
+		Element& getEntry (Element& x, size_t i, size_t j) const
 		{
-			for (size_t i=0; i< _rep.size();++i)
-				_entry[i]=_rep[i]->getEntry(i,j);
-			return _entry;
+			x.resize(size());
+			for (size_t l=0; l< size();++l)
+				x[l] = _rep[(l*_row+i)*_col+j];
+			return x;
 		}
 
-		BlasMatrix<Givaro::Modular<double> >*& getMatrix(size_t i) {return _rep[i];}
+		const Element& getEntry (size_t i, size_t j) const
+		{
+			return getEntry(_entry, i, j);
+		}
 
 	};
 
 
-	template <>
-	class MatrixContainerTrait<BlasMatrix<MultiModDouble> > {
+	template <class _Storage>
+	class MatrixContainerTrait<BlasMatrix<MultiModDouble,_Storage> > {
 	public:
 		typedef MatrixContainerCategory::Blackbox Type;
 	};
 } // LinBox
 
-#endif // __LINBOX_blas_matrix_H
+#endif // __LINBOX_blas_matrix_multimod_H
 
 // Local Variables:
 // mode: C++
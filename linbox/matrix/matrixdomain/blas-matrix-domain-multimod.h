@@ -0,0 +1,255 @@
+/* linbox/matrix/matrixdomain/blas-matrix-domain-multimod.h
+ * Copyright (C) 2019 the LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file matrix/matrixdomain/blas-matrix-domain-multimod.h
+ * @ingroup matrixdomain
+ * @brief BlasMatrixDomain over a MultiModDouble.
+ * Every operation is done plane by plane with FFLAS/FFPACK on the residue
+ * planes of <code>BlasMatrix<MultiModDouble></code>, the planes being
+ * processed in parallel when OpenMP is enabled.
+ */
+
+#ifndef __LINBOX_blas_matrix_domain_multimod_H
+#define __LINBOX_blas_matrix_domain_multimod_H
+
+#include <vector>
+#include <algorithm>
+#include <fflas-ffpack/ffpack/ffpack.h>
+#include <fflas-ffpack/fflas/fflas.h>
+#ifdef __LINBOX_USE_OPENMP
+#include <omp.h>
+#endif
+
+#include "linbox/util/debug.h"
+#include "linbox/field/multimod-field.h"
+#include "linbox/matrix/matrixdomain/blas-matrix-domain.h"
+#include "linbox/matrix/densematrix/blas-matrix-multimod.h"
+
+namespace LinBox
+{
+
+	/*! BlasMatrixDomain over a MultiModDouble.
+	 * Scalars are elements of the MultiModDouble (one residue per plane).
+	 * Ranks and nullities may differ from plane to plane:
+	 * \c rank returns the largest one (the rank over the integers
+	 * when the matrix was reduced from an integer one), the per plane
+	 * values are available through the overloads taking a vector.
+	 */
+	template<>
+	class BlasMatrixDomain<MultiModDouble> {
+
+	public:
+		typedef MultiModDouble                 Field;
+		typedef Field::Element               Element;
+		typedef BlasMatrix<MultiModDouble>    Matrix;
+		typedef Matrix                     OwnMatrix;
+		typedef Givaro::Modular<double>    BaseField;
+
+	protected:
+
+		const Field  * _field;
+
+		//! Run \p f on each plane, in parallel if the work is large enough.
+		template<class Function>
+		void forPlanes(size_t work, Function f) const
+		{
+			const long k((long)field().size());
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(dynamic) if (k > 1 && work > (1<<15))
+#endif
+			for (long l = 0; l < k; ++l)
+				f((size_t)l);
+		}
+
+	public:
+
+		BlasMatrixDomain () {}
+		BlasMatrixDomain (const Field& F ) { init(F); }
+
+		void init(const Field& F ){_field = &F;}
+
+		BlasMatrixDomain (const BlasMatrixDomain<Field> & BMD): _field(BMD._field) {}
+
+		const Field& field() const { return *_field; }
+
+		//! C= beta.C + alpha.A*B.
+		template <class Matrix1, class Matrix2, class Matrix3>
+		Matrix1& muladdin(const Element& beta, Matrix1& C,
+				  const Element& alpha, const Matrix2& A, const Matrix3& B) const
+		{
+			linbox_check(A.coldim() == B.rowdim());
+			linbox_check(C.rowdim() == A.rowdim() && C.coldim() == B.coldim());
+			const size_t m = A.rowdim(), n = B.coldim(), k = A.coldim();
+			forPlanes(m*n*k, [&](size_t l) {
+				const BaseField& F = field().getBase(l);
+				FFLAS::fgemm(F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, m, n, k,
+					     alpha[l], A.getPointer(l), A.getStride(), B.getPointer(l), B.getStride(),
+					     beta[l], C.getPointer(l), C.getStride());
+			});
+			return C;
+		}
+
+		//! D= beta.C + alpha.A*B
+		template <class Matrix1, class Matrix2, class Matrix3, class Matrix4>
+		Matrix1& muladd(Matrix1& D, const Element& beta, const Matrix2& C,
+				const Element& alpha, const Matrix3& A, const Matrix4& B) const
+		{
+			D = C;
+			return muladdin(beta, D, alpha, A, B);
+		}
+
+		//! C = A*B
+		template <class Matrix1, class Matrix2, class Matrix3>
+		Matrix1& mul(Matrix1& C, const Matrix2& A, const Matrix3& B) const
+		{
+			Element one, zero;
+			field().init(one, 1.); field().init(zero, 0.);
+			C.resize(A.rowdim(), B.coldim());
+			return muladdin(zero, C, one, A, B);
+		}
+
+		//! C += A*B
+		template <class Matrix1, class Matrix2, class Matrix3>
+		Matrix1& axpyin(Matrix1& C, const Matrix2& A, const Matrix3& B) const
+		{
+			Element one;
+			field().init(one, 1.);
+			return muladdin(one, C, one, A, B);
+		}
+
+		//! D = A*B + C
+		template <class Matrix1, class Matrix2, class Matrix3, class Matrix4>
+		Matrix1& axpy(Matrix1& D, const Matrix2& A, const Matrix3& B, const Matrix4& C) const
+		{
+			D = C;
+			return axpyin(D, A, B);
+		}
+
+		//! C -= A*B
+		template <class Matrix1, class Matrix2, class Matrix3>
+		Matrix1& maxpyin(Matrix1& C, const Matrix2& A, const Matrix3& B) const
+		{
+			Element one, mOne;
+			field().init(one, 1.); field().init(mOne, 1.); field().negin(mOne);
+			return muladdin(one, C, mOne, A, B);
+		}
+
+		/*! Inversion w singular check.
+		 * \p nullity is the largest nullity among the planes, so that
+		 * \p Ainv is the inverse of \p A modulo every prime iff it is 0.
+		 */
+		template <class Matrix1, class Matrix2>
+		Matrix1& inv( Matrix1 &Ainv, const Matrix2 &A, int& nullity) const
+		{
+			linbox_check(A.rowdim() == A.coldim());
+			const size_t n = A.rowdim();
+			Ainv.resize(n, n);
+			std::vector<int> nul(field().size(), 0);
+			forPlanes(n*n*n, [&](size_t l) {
+				FFPACK::Invert(field().getBase(l), n, A.getPointer(l), A.getStride(),
+					       Ainv.getPointer(l), Ainv.getStride(), nul[l]);
+			});
+			nullity = nul.empty() ? 0 : *std::max_element(nul.begin(), nul.end());
+			return Ainv;
+		}
+
+		//! Inversion
+		template <class Matrix1, class Matrix2>
+		Matrix1& inv( Matrix1 &Ainv, const Matrix2 &A) const
+		{
+			int nullity;
+			return inv(Ainv, A, nullity);
+		}
+
+		//! Inversion (the matrix A is modified)
+		template <class Matrix1>
+		Matrix1& invin(Matrix1 &A) const
+		{
+			Matrix1 tmp(A);
+			return inv(A, tmp);
+		}
+
+		//! Ranks modulo each prime (the matrix is modified)
+		template <class Matrix1>
+		std::vector<size_t>& rankInPlace(std::vector<size_t>& r, Matrix1 &A) const
+		{
+			const size_t m = A.rowdim(), n = A.coldim();
+			r.assign(field().size(), 0);
+			forPlanes(m*n*std::min(m,n), [&](size_t l) {
+				r[l] = FFPACK::Rank(field().getBase(l), m, n, A.getPointer(l), A.getStride());
+			});
+			return r;
+		}
+
+		//! in-place Rank: the largest rank modulo the primes
+		template <class Matrix1>
+		unsigned int rankInPlace(Matrix1 &A) const
+		{
+			std::vector<size_t> r;
+			rankInPlace(r, A);
+			return r.empty() ? 0 : (unsigned int)*std::max_element(r.begin(), r.end());
+		}
+
+		//! Rank: the largest rank modulo the primes
+		template <class Matrix1>
+		unsigned int rank(const Matrix1 &A) const
+		{
+			Matrix1 Acopy(A);
+			return rankInPlace(Acopy);
+		}
+
+		//! in-place Determinant (the matrix is modified)
+		template <class Matrix1>
+		Element detInPlace(Matrix1 &A) const
+		{
+			Element d;
+			field().init(d, 0.);
+			if (A.rowdim() != A.coldim())
+				return d;
+			const size_t n = A.rowdim();
+			forPlanes(n*n*n, [&](size_t l) {
+				FFPACK::Det(field().getBase(l), d[l], n, A.getPointer(l), A.getStride());
+			});
+			return d;
+		}
+
+		//! determinant
+		template <class Matrix1>
+		Element det(const Matrix1 &A) const
+		{
+			Matrix1 Acopy(A);
+			return detInPlace(Acopy);
+		}
+
+	};
+
+} // LinBox
+
+#endif // __LINBOX_blas_matrix_domain_multimod_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -30,6 +30,7 @@
 
 #include "linbox/field/hom.h"
 #include "fflas-ffpack/utils/align-allocator.h"
+#include "fflas-ffpack/paladin/parallel.h"
 #include "givaro/modular.h"
 #include <algorithm>
 
@@ -48,11 +49,80 @@ uint64_t max_memory=0, cur_memory=0;
 
 #define COPY_BLOCKSIZE 32
 
+// Number of halving levels of a layout transposition run as parallel tasks
+#if !defined(LINBOX_TRANSPOSE_PAR_DEPTH)
+#define LINBOX_TRANSPOSE_PAR_DEPTH 3
+#endif
+
+// Layout transpositions with at most this number of entries are sequential
+#if !defined(LINBOX_TRANSPOSE_PAR_THRESHOLD)
+#define LINBOX_TRANSPOSE_PAR_THRESHOLD 65536
+#endif
+
 namespace LinBox{
 
     
 	enum PMType {polfirst, matfirst, matrowfirst};
 
+    namespace Protected {
+        /* Cache-oblivious transposition of the r x c matrix src (leading
+         * dimension lds) into dst (leading dimension ldd):
+         *     dst[j*ldd+i] = src[i*lds+j]
+         * the largest dimension is halved until the block has at most
+         * COPY_BLOCKSIZE^2 entries. This converts a block of points from
+         * polfirst to matfirst storage and back.
+         */
+        template<typename Element>
+        void transpose_co(Element* dst, size_t ldd, const Element* src, size_t lds, size_t r, size_t c) {
+            if (r*c <= COPY_BLOCKSIZE*COPY_BLOCKSIZE) {
+                for (size_t i=0;i<r;i++)
+                    for (size_t j=0;j<c;j++)
+                        dst[j*ldd+i]=src[i*lds+j];
+            }
+            else if (r >= c) {
+                size_t h=r>>1;
+                transpose_co(dst, ldd, src, lds, h, c);
+                transpose_co(dst+h, ldd, src+h*lds, lds, r-h, c);
+            }
+            else {
+                size_t h=c>>1;
+                transpose_co(dst, ldd, src, lds, r, h);
+                transpose_co(dst+h*ldd, ldd, src+h, lds, r, c-h);
+            }
+        }
+
+        /* Same as transpose_co, the two halves of the first \p depth
+         * levels being transposed by parallel tasks when called within a
+         * PAR_BLOCK. This is the engine of the conversions between the
+         * polfirst, matfirst and matrowfirst storages.
+         */
+        template<typename Element>
+        void transpose_par(Element* dst, size_t ldd, const Element* src, size_t lds, size_t r, size_t c,
+                           size_t depth=LINBOX_TRANSPOSE_PAR_DEPTH) {
+            if (depth==0 || r*c <= LINBOX_TRANSPOSE_PAR_THRESHOLD) {
+                transpose_co(dst, ldd, src, lds, r, c);
+                return;
+            }
+            size_t r0=r, c0=c, r1=r, c1=c;
+            Element* dst1;
+            const Element* src1;
+            if (r >= c) {
+                r0=r>>1; r1=r-r0;
+                dst1=dst+r0; src1=src+r0*lds;
+            }
+            else {
+                c0=c>>1; c1=c-c0;
+                dst1=dst+c0*ldd; src1=src+c0;
+            }
+            SYNCH_GROUP(
+                { TASK(MODE(VALUE(dst,src,r0,c0)),
+                       { transpose_par(dst, ldd, src, lds, r0, c0, depth-1); })}
+                { TASK(MODE(VALUE(dst1,src1,r1,c1)),
+                       { transpose_par(dst1, ldd, src1, lds, r1, c1, depth-1); })}
+            )
+        }
+    }
+
 
     // matrix example
     /*  [ 1+2X+3X^2  4+5X+6X^2 ]
@@ -141,6 +211,9 @@ namespace LinBox{
 
         view       at(size_t i, size_t j)      {return view(*this,i,j);}
         const_view at(size_t i, size_t j)const {return const_view(*this,i,j);}
+        // view of the coefficients i, i+step, ... up to j, without copy
+        view       at(size_t i, size_t j, size_t step)       {return view(*this,i,j,step);}
+        const_view at(size_t i, size_t j, size_t step) const {return const_view(*this,i,j,step);}
 
 
         // initializee matrix entries at random
@@ -219,27 +292,19 @@ namespace LinBox{
 		// M is stored as a Polynomial of Matrices
 		void copy(const PolynomialMatrix<Field, PMType::matfirst>& M, size_t beg, size_t end, size_t start=0){
 			//std::cout<<"copying.....matfirst to polfirst.....same field"<<std::endl;
-			const size_t ls = COPY_BLOCKSIZE;
-			for (size_t i = beg; i <= end; i+=ls)
-				for (size_t j = 0; j < _col * _row; j+=ls)
-					// Rk: the two loop must be interchanged in some cases
-					for (size_t _i = i; _i < std::min(end+1, i + ls); _i++)
-						for (size_t _j = j; _j < std::min(_col * _row, j + ls);++_j)
-							ref(_j,start+_i-beg)= M.get(_j,_i);
+			// (end-beg+1) x (_row*_col) block of M transposed into the columns start.. of the storage
+			Protected::transpose_par(getPointer()+start, _size, M.getPointer()+beg*_row*_col, _row*_col,
+									 end-beg+1, _row*_col);
 		}
 
         // copy elt from M[beg..end], _size must be >= end-beg+1
 		// M is stored with the hybrid format matrowfirst
 		void copy(const PolynomialMatrix<Field, PMType::matrowfirst>& M, size_t beg, size_t end, size_t start=0){
 			//std::cout<<"copying.....matrowfirst to polfirst.....same field"<<std::endl;
-			const size_t ls = COPY_BLOCKSIZE;
-            for(size_t k=0;k<_row;k++){
-                for (size_t i = beg; i <= end; i+=ls)
-                    for (size_t j = 0; j < _col; j+=ls)        
-                        for (size_t _i = i; _i < std::min(end+1, i + ls); _i++)
-                            for (size_t _j = j; _j < std::min(_col, j + ls);++_j)
-                                ref(k,_j,start+_i-beg)= M.get(k,_j,_i);
-            }
+			// row k of M is a (M.size() x _col) block
+            for(size_t k=0;k<_row;k++)
+                Protected::transpose_par(getPointer()+k*_col*_size+start, _size,
+                                         M.getPointer()+k*M.row_stride()+beg*_col, _col, end-beg+1, _col);
         }
 
         
@@ -299,7 +364,11 @@ namespace LinBox{
 
         template<class MatPoly>
         void copy(const SubPolynomialMatrix<MatPoly>& M, size_t beg, size_t end, size_t start=0){
-            copy(*M._ptr, beg+M._shift, end+M._shift,start);
+            if (M._step==1)
+                copy(*M._ptr, beg+M._shift, end+M._shift,start);
+            else
+                for (size_t k=beg;k<=end;k++)
+                    copy(*M._ptr, k*M._step+M._shift, k*M._step+M._shift, start+k-beg);
         }
 
         
@@ -465,6 +534,9 @@ namespace LinBox{
 
         view       at(size_t i, size_t j)       {return view(*this,i,j);}
         const_view at(size_t i, size_t j) const {return const_view(*this,i,j);}
+        // view of the coefficients i, i+step, ... up to j, without copy
+        view       at(size_t i, size_t j, size_t step)       {return view(*this,i,j,step);}
+        const_view at(size_t i, size_t j, size_t step) const {return const_view(*this,i,j,step);}
 
 
 		// resize the polynomial length of the polynomial matrix
@@ -482,14 +554,11 @@ namespace LinBox{
         // copy elt from M[beg..end], _size must be >= end-beg+1
 		// M is stored with the hybrid format matrowfirst
 		void copy(const PolynomialMatrix<Field, PMType::matrowfirst>& M, size_t beg, size_t end, size_t start=0){
-			//std::cout<<"copying.....matrowfirst to polfirst.....same field"<<std::endl;
-			const size_t ls = COPY_BLOCKSIZE;
-            for (size_t i = beg; i <= end; i+=ls)
-                for (size_t j = 0; j < _row; j+=ls)        
-                    for (size_t _i = i; _i < std::min(end+1, i + ls); _i++)
-                        for (size_t _j = j; _j < std::min(_row, j + ls);++_j)
-                            for(size_t k=0;k<_col;k++)
-                                ref(k,_j,start+_i-beg)= M.get(k,_j,_i);            
+			//std::cout<<"copying.....matrowfirst to matfirst.....same field"<<std::endl;
+			// no transposition: row k of each coefficient is contiguous in both storages
+            for(size_t k=0;k<_row;k++)
+                FFLAS::fassign(field(), end-beg+1, _col, M.getPointer()+k*M.row_stride()+beg*_col, _col,
+                               getPointer()+start*_row*_col+k*_col, _row*_col);
         }
 
 
@@ -507,13 +576,9 @@ namespace LinBox{
 		// M is stored as a Matrix of Polynomials
 		void copy(const PolynomialMatrix<Field, PMType::polfirst>& M, size_t beg, size_t end, size_t start=0){
 			//cout<<"copying.....polfirst to matfirst.....same field"<<endl;
-			const size_t ls = COPY_BLOCKSIZE; // Loop unrooling to be more cache-friendly (cache block transposition)
-			for(size_t i = beg; i < end+1; i+=ls)
-				for (size_t j = 0; j < _col * _row; j+=ls)
-					for (size_t _i = i; _i < std::min(end+1, i + ls); _i++) {
-						for (size_t _j = j; _j < std::min(_col * _row, j + ls); _j++)
-							ref(_j,start+_i-beg) = M.get(_j,_i);
-					}
+			// (_row*_col) x (end-beg+1) block of M transposed into the rows start.. of the storage
+			Protected::transpose_par(getPointer()+start*_row*_col, _row*_col, M.getPointer()+beg, M.size(),
+									 _row*_col, end-beg+1);
 		}
 
 		// copy elt from M[beg..end], _size must be >= end-beg+1
@@ -540,7 +605,11 @@ namespace LinBox{
 
         template<class MatPoly>
         void copy(const SubPolynomialMatrix<MatPoly>& M, size_t beg, size_t end, size_t start=0){
-            copy(*M._ptr, beg+M._shift, end+M._shift,start);
+            if (M._step==1)
+                copy(*M._ptr, beg+M._shift, end+M._shift,start);
+            else
+                for (size_t k=beg;k<=end;k++)
+                    copy(*M._ptr, k*M._step+M._shift, k*M._step+M._shift, start+k-beg);
         }
 
         
@@ -723,6 +792,9 @@ namespace LinBox{
 
         view       at(size_t i, size_t j)       {return view(*this,i,j);}
         const_view at(size_t i, size_t j) const {return const_view(*this,i,j);}
+        // view of the coefficients i, i+step, ... up to j, without copy
+        view       at(size_t i, size_t j, size_t step)       {return view(*this,i,j,step);}
+        const_view at(size_t i, size_t j, size_t step) const {return const_view(*this,i,j,step);}
 
 
 
@@ -778,15 +850,10 @@ namespace LinBox{
 		// copy elt from M[beg..end], _size must be >= end-beg+1
 		// M is stored as a Matrix of Polynomials
 		void copy(const PolynomialMatrix<Field, PMType::polfirst>& M, size_t beg, size_t end, size_t start=0){
-			const size_t ls = COPY_BLOCKSIZE; // Loop unrooling to be more cache-friendly (cache block transposition)
-            for(size_t k=0;k<_row;k++) {
-                for(size_t i = beg; i < end+1; i+=ls)
-                    for (size_t j = 0; j < _col; j+=ls)
-                        for (size_t _i = i; _i < std::min(end+1, i + ls); _i++) {
-                            for (size_t _j = j; _j < std::min(_col, j + ls); _j++)
-                                ref(k,_j,start+_i-beg) = M.get(k,_j,_i);
-                        }
-            }
+            // row k of M is a (_col x M.size()) block
+            for(size_t k=0;k<_row;k++)
+                Protected::transpose_par(getPointer()+k*_stride+start*_col, _col,
+                                         M.getPointer()+k*_col*M.size()+beg, M.size(), _col, end-beg+1);
         }
 
 		// copy elt from M[beg..end], _size must be >= end-beg+1
@@ -811,7 +878,11 @@ namespace LinBox{
 
         template<class MatPoly>
         void copy(const SubPolynomialMatrix<MatPoly>& M, size_t beg, size_t end, size_t start=0){
-            copy(*M._ptr, beg+M._shift, end+M._shift,start);
+            if (M._step==1)
+                copy(*M._ptr, beg+M._shift, end+M._shift,start);
+            else
+                for (size_t k=beg;k<=end;k++)
+                    copy(*M._ptr, k*M._step+M._shift, k*M._step+M._shift, start+k-beg);
         }
 
         
@@ -899,6 +970,7 @@ namespace LinBox{
 		size_t degree()  const {return _size-1;}
 		size_t size()    const {return _size;}
         size_t poly_stride() const {return _row;}        
+        size_t row_stride()  const {return _stride;}
 		const Field& field()  const {return _rep.field();}        
 
     private:
@@ -937,6 +1009,7 @@ namespace LinBox{
     
     
 	// Class to handle the view of a Polynomial Matrix according to some degree range
+	// the coefficients of the view may be taken every _step coefficients (e.g. even or odd part)
 	template<class MatPoly>
 	class SubPolynomialMatrix {
 	public:
@@ -953,30 +1026,44 @@ namespace LinBox{
 
 		// constructor of a view between i and j from a plain Polynomial Matrix
 		SubPolynomialMatrix(MatPoly& M, size_t i,size_t j)
-			: _ptr(&M), _size(j-i+1), _shift(i)
+			: _ptr(&M), _size(j-i+1), _shift(i), _step(1)
 		{
             linbox_check(i<M.size() && i<=j && j< M.size());
             //if (i>=M.size() || (i>j)) {_size=0;}
         }
 
+		// constructor of a view of the coefficients i, i+step, ... up to j from a plain Polynomial Matrix
+		SubPolynomialMatrix(MatPoly& M, size_t i,size_t j, size_t step)
+			: _ptr(&M), _size((j-i)/step+1), _shift(i), _step(step)
+		{
+            linbox_check(step>0 && i<M.size() && i<=j && j< M.size());
+        }
+
 		// constructor of a view between i and j from a Sub Polynomial Matrix
 		SubPolynomialMatrix(Self_t & M, size_t i,size_t j)
-			: _ptr(M._ptr), _size(j-i+1), _shift(i+M._shift)
+			: _ptr(M._ptr), _size(j-i+1), _shift(i*M._step+M._shift), _step(M._step)
 		{
             linbox_check(i<M.size() && i<=j && j< M.size());
             //if (i>=M.size() || (i>j)) {_size=0;}
         }
 
+		// constructor of a view of the coefficients i, i+step, ... up to j from a Sub Polynomial Matrix
+		SubPolynomialMatrix(Self_t & M, size_t i,size_t j, size_t step)
+			: _ptr(M._ptr), _size((j-i)/step+1), _shift(i*M._step+M._shift), _step(step*M._step)
+		{
+            linbox_check(step>0 && i<M.size() && i<=j && j< M.size());
+        }
+
         // copy the matrix of degree k into A
         template<typename DenseMatrix>
 		DenseMatrix& getMatrix(DenseMatrix& A, size_t k) const {
-            return _ptr->getMatrix(A,k+_shift);
+            return _ptr->getMatrix(A,k*_step+_shift);
         }
 
         // copy the matrix A into the matrix of degree 
         template<typename DenseMatrix>
 		void setMatrix(const DenseMatrix& A, size_t k)  {
-            return _ptr->setMatrix(A,k+_shift);
+            return _ptr->setMatrix(A,k*_step+_shift);
         }
 
         // only shrink down the size, increase is not possible
@@ -990,7 +1077,11 @@ namespace LinBox{
 
         template <typename Mat>
         void copy(const Mat & M, size_t beg, size_t end){
-            _ptr->copy(M,beg,end,_shift);
+            if (_step==1)
+                _ptr->copy(M,beg,end,_shift);
+            else
+                for (size_t k=beg;k<=end;k++)
+                    _ptr->copy(M,k,k,(k-beg)*_step+_shift);
 		}
         
 		template<typename Mat>
@@ -1000,14 +1091,14 @@ namespace LinBox{
 
         
 		// retrieve the matrix of degree k in the polynomial matrix
-        Matrix  operator[](size_t k) const {return _ptr->operator[](k+_shift);}
+        Matrix  operator[](size_t k) const {return _ptr->operator[](k*_step+_shift);}
 
 		// retrieve the polynomial at entry (i,j) in the matrix
         Polynomial    operator()(size_t i, size_t j){
             return Polynomial(_ptr->operator()(i,j),i, _ptr->poly_stride(), j-i+1);
         }
 
-        Element get(size_t i, size_t k) const { return 	_ptr->get(i,k+_shift);}
+        Element get(size_t i, size_t k) const { return 	_ptr->get(i,k*_step+_shift);}
 
         Element get(size_t i, size_t j, size_t k) const{ return get(i*coldim()+j,k);}
 
@@ -1015,13 +1106,23 @@ namespace LinBox{
         size_t coldim() const {return _ptr->coldim();}
         size_t degree() const {return _size-1;}
         size_t size()   const {return _size;}
+        size_t step()   const {return _step;}
         const Field& field()  const {return _ptr->field();}
 
 
-        const_view at(size_t i, size_t j) const {return const_view(*_ptr,i+_shift,j+_shift);}
-        view       at(size_t i, size_t j)       {return       view(*_ptr,i+_shift,j+_shift);}
+        const_view at(size_t i, size_t j) const {return const_view(*_ptr,i*_step+_shift,j*_step+_shift,_step);}
+        view       at(size_t i, size_t j)       {return       view(*_ptr,i*_step+_shift,j*_step+_shift,_step);}
+        // view of the coefficients i, i+step, ... up to j of this view, the steps compose
+        const_view at(size_t i, size_t j, size_t step) const {return const_view(*_ptr,i*_step+_shift,j*_step+_shift,step*_step);}
+        view       at(size_t i, size_t j, size_t step)       {return       view(*this,i,j,step);}
         
-		std::ostream& write(std::ostream& os) const { if (_size!=0) return _ptr->write(os,_shift,_shift+_size-1); else return os;}
+		std::ostream& write(std::ostream& os) const {
+            if (_size==0) return os;
+            if (_step==1) return _ptr->write(os,_shift,_shift+_size-1);
+            for (size_t k=0;k<_size;k++)
+                _ptr->write(os,k*_step+_shift,k*_step+_shift)<<std::endl;
+            return os;
+        }
 
         
 
@@ -1033,6 +1134,7 @@ namespace LinBox{
 		MatPoly* _ptr;
 		size_t  _size;
 		size_t _shift;
+		size_t  _step;
 	};
 
 	template<typename MatPoly>      
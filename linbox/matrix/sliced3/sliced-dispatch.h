@@ -0,0 +1,96 @@
+/* linbox/matrix/sliced3/sliced-dispatch.h
+ * Copyright (C) 2020 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file matrix/sliced3/sliced-dispatch.h
+ * @ingroup matrix
+ * @brief In place dense rank and det, GF(3) stored in bytes going bit-sliced.
+ * This is the only place where the solutions see the sliced domain.
+ */
+
+#ifndef __LINBOX_matrix_sliced3_sliced_dispatch_H
+#define __LINBOX_matrix_sliced3_sliced_dispatch_H
+
+#include "linbox/ring/modular.h"
+#include "linbox/matrix/dense-matrix.h"
+#include "linbox/matrix/matrixdomain/blas-matrix-domain.h"
+#include "linbox/matrix/sliced3.h"
+
+namespace LinBox
+{
+	namespace Protected {
+		template <class Field>
+		inline size_t blasRankInPlace (BlasMatrix<Field> &B)
+		{
+			BlasMatrixDomain<Field> D(B.field());
+			return D.rankInPlace(B);
+		}
+
+		template <class Field>
+		inline typename Field::Element &blasDetInPlace (typename Field::Element &d, BlasMatrix<Field> &B)
+		{
+			BlasMatrixDomain<Field> BMD(B.field());
+			return d = BMD.detInPlace(B);
+		}
+
+		/// GF(3) stored in bytes is eliminated bit-sliced, 64 entries per word
+		template <class Compute_t>
+		inline size_t blasRankInPlace (BlasMatrix<Givaro::Modular<uint8_t,Compute_t> > &B)
+		{
+			typedef Givaro::Modular<uint8_t,Compute_t> Field;
+			if (B.field().characteristic() != 3) {
+				BlasMatrixDomain<Field> D(B.field());
+				return D.rankInPlace(B);
+			}
+			typedef MatrixDomain<SlicedField<Field,uint64_t> > SlicedDomain;
+			SlicedDomain SD;
+			typename SlicedDomain::Matrix S(SD);
+			SD.copy(S, B);
+			return SD.rankInPlace(S);
+		}
+
+		/// GF(3) stored in bytes is eliminated bit-sliced, 64 entries per word
+		template <class Compute_t>
+		inline uint8_t &blasDetInPlace (uint8_t &d, BlasMatrix<Givaro::Modular<uint8_t,Compute_t> > &B)
+		{
+			typedef Givaro::Modular<uint8_t,Compute_t> Field;
+			if (B.field().characteristic() != 3) {
+				BlasMatrixDomain<Field> BMD(B.field());
+				return d = BMD.detInPlace(B);
+			}
+			typedef MatrixDomain<SlicedField<Field,uint64_t> > SlicedDomain;
+			SlicedDomain SD;
+			typename SlicedDomain::Matrix S(SD);
+			SD.copy(S, B);
+			return SD.detInPlace(d, S);
+		}
+	}
+}
+
+#endif // __LINBOX_matrix_sliced3_sliced_dispatch_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -1,6 +1,7 @@
 #ifndef __SLICED_DOMAIN_H
 #define __SLICED_DOMAIN_H
 
+#include <vector>
 #include "dense-sliced.h"
 #include "linbox/matrix/matrix-domain.h"
 
@@ -14,6 +15,11 @@ A Blackbox is any matrix type that has apply and applyTranspose applicable to Ma
 SlicedDomain provides, for A a Matrix and B a Blackbox(preconditioner) 
   mulin(A, B) // A *= B
   addin(A, A2) // A += A2
+
+and, on row packed matrices which are not submatrices,
+  mul(C, A, B) // C = A*B, four Russians on the sliced words
+  spmul(Y, S, X) // Y = S*X, S sparse (IndexedBegin/IndexedEnd)
+  PLUQ(A, P, Q), rankInPlace(A), detInPlace(d, A), nullspace(N, A)
 */
 
 namespace LinBox {
@@ -108,6 +114,50 @@ public:
 		return A.axpyin(Ab, Ae, x, Bb);
 	}
 
+	/** C <-- A * B, both row sliced.
+	 * Method of four Russians: the 81 combinations of each group of
+	 * 4 rows of B are tabulated and each row of A takes one lookup per group.
+	 */
+	Matrix& mul (Matrix& C, Matrix& A, Matrix& B);
+
+	/** Y <-- S * X, S sparse over any field of characteristic 3,
+	 * X row sliced. Each non-zero of S costs one sliced row axpy.
+	 */
+	template <class Sparse>
+	Matrix& spmul (Matrix& Y, const Sparse& S, Matrix& X);
+
+	/** A <-- S mod 3, S any matrix with field() and getEntry().
+	 * A is resized.
+	 */
+	template <class Gettable>
+	Matrix& copy (Matrix& A, const Gettable& S);
+
+	/** PLUQ factorization of A, in place.
+	 * The pivot rows of A become U, in row echelon form, and the
+	 * multipliers of L are stored below the pivots.
+	 * P and Q are LAPACK style transpositions: row k was exchanged with
+	 * row P[k], the k-th pivot is in column Q[k].
+	 * @return rank of A
+	 */
+	size_t PLUQ (Matrix& A, std::vector<size_t>& P, std::vector<size_t>& Q) {
+		return echelon(A, P, Q, true);
+	}
+
+	/// rank of A, A is modified
+	size_t rankInPlace (Matrix& A) {
+		std::vector<size_t> P, Q;
+		return echelon(A, P, Q, false);
+	}
+
+	/// determinant of A, A is modified
+	Element& detInPlace (Element& d, Matrix& A);
+
+	/** Right nullspace of A: the columns of N are a basis of \f$\{x, Ax = 0\}\f$.
+	 * A is modified (reduced row echelon form).
+	 * @return dimension of the nullspace
+	 */
+	size_t nullspace (Matrix& N, Matrix& A);
+
 	//  C += A * B
 	Matrix& axpyin(Matrix& C, Matrix& A, Matrix &B) {
 		//  temp mat to store mul
@@ -160,9 +210,22 @@ public:
 			}
 		return is; 
 	}
+
+protected:
+	typedef SlicedBase<Word_T> Unit;
+
+	// Gaussian elimination on the rows of A, L kept below the pivots if storeL
+	size_t echelon (Matrix& A, std::vector<size_t>& P, std::vector<size_t>& Q, bool storeL);
+
+	// y[w] += x[w] (or -x[w]) for w in [w0, w1), only the bits of mask are touched in y[w0]
+	static void axpyinRow (Unit* y, const Unit* x, bool negate, size_t w0, size_t w1, Word_T mask);
+
+	static Unit* row (Matrix& A, size_t i) { return A._rep + i*A._stride; }
 };
 
 }
+
+#include "sliced-domain.inl"
 	
 #endif // __SLICED_DOMAIN_H
 
@@ -0,0 +1,278 @@
+/* linbox/matrix/sliced3/sliced-domain.inl
+ * Copyright (C) 2013 the LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*
+  Word level matrix functions of the sliced GF(3) domain.
+
+  An element is one bit of b0 plus one bit of b1 (b1 set only where b0 is):
+  0 = (0,0), 1 = (1,0), 2 = (1,1).  Negation is b1 ^= b0.
+  All the functions below work on whole rows of row packed matrices
+  which are not submatrices, so that row i is _rep + i*_stride
+  and holds _cols sliced units.
+*/
+
+#ifndef __SLICED_DOMAIN_INL
+#define __SLICED_DOMAIN_INL
+
+#include <algorithm>
+#include <cstdint>
+#ifdef __LINBOX_USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace LinBox {
+
+template<class _Field,class _WordT>
+inline void MatrixDomain<SlicedField<_Field,_WordT> >::axpyinRow
+(Unit* y, const Unit* x, bool negate, size_t w0, size_t w1, Word_T mask)
+{
+	if (w0 >= w1) return;
+	const Word_T two(2);
+
+	Unit s = y[w0];
+	s += negate ? x[w0]*two : x[w0];
+	y[w0].b0 = (y[w0].b0 & ~mask) | (s.b0 & mask);
+	y[w0].b1 = (y[w0].b1 & ~mask) | (s.b1 & mask);
+
+	if (negate)
+		for (size_t w = w0+1; w < w1; ++w) y[w] += x[w]*two;
+	else
+		for (size_t w = w0+1; w < w1; ++w) y[w] += x[w];
+}
+
+template<class _Field,class _WordT>
+inline typename MatrixDomain<SlicedField<_Field,_WordT> >::Matrix&
+MatrixDomain<SlicedField<_Field,_WordT> >::mul (Matrix& C, Matrix& A, Matrix& B)
+{
+	linbox_check(A.coldim() == B.rowdim());
+	linbox_check(C.rowdim() == A.rowdim() && C.coldim() == B.coldim());
+	C.zero();
+
+	const size_t SIZE = 8*sizeof(Word_T), K = 4, TS = 81;
+	const size_t m = A.rowdim(), k = A.coldim(), W = B._cols;
+
+	// 4 bits of b0 and 4 bits of b1 -> base 3 index of the 4 entries
+	size_t keys[256];
+	for (size_t c = 0; c < 256; ++c) {
+		size_t key = 0;
+		for (size_t t = K; t-- > 0; )
+			key = 3*key + ((c >> (4+t)) & 1) + ((c >> t) & 1);
+		keys[c] = key;
+	}
+
+	std::vector<Unit> T(TS*W);
+	for (size_t l0 = 0; l0 < k; l0 += K) {
+		const size_t kb = std::min(K, k-l0);
+		size_t nt = 1;
+		for (size_t t = 0; t < kb; ++t) nt *= 3;
+
+		// T[key] = sum_t d_t B[l0+t], key = sum_t d_t 3^t
+		for (size_t w = 0; w < W; ++w) T[w].zero();
+		for (size_t key = 1; key < nt; ++key) {
+			size_t t = 0, q = key, p = 1;
+			for ( ; q % 3 == 0; q /= 3, p *= 3) ++t;
+			const size_t d = q % 3;
+			const Unit* prev(&T[(key - d*p)*W]);
+			const Unit* b(row(B, l0+t));
+			Unit* cur(&T[key*W]);
+			for (size_t w = 0; w < W; ++w) {
+				cur[w] = prev[w];
+				cur[w] += (d == 2) ? b[w]*Word_T(2) : b[w];
+			}
+		}
+
+		const size_t w0 = l0 / SIZE, shift = l0 % SIZE;
+		const Word_T mask = (Word_T(1) << kb) - 1;
+		const long lm((long)m);
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(static) if (m*W > (1<<14))
+#endif
+		for (long i = 0; i < lm; ++i) {
+			const Unit& a = row(A, (size_t)i)[w0];
+			const size_t c = (size_t)((((a.b1 >> shift) & mask) << 4) | ((a.b0 >> shift) & mask));
+			const size_t key = keys[c];
+			if (key == 0) continue;
+			Unit* ci(row(C, (size_t)i));
+			const Unit* tk(&T[key*W]);
+			for (size_t w = 0; w < W; ++w) ci[w] += tk[w];
+		}
+	}
+	return C;
+}
+
+template<class _Field,class _WordT>
+template <class Sparse>
+inline typename MatrixDomain<SlicedField<_Field,_WordT> >::Matrix&
+MatrixDomain<SlicedField<_Field,_WordT> >::spmul (Matrix& Y, const Sparse& S, Matrix& X)
+{
+	linbox_check(S.coldim() == X.rowdim());
+	linbox_check(Y.rowdim() == S.rowdim() && Y.coldim() == X.coldim());
+	Y.zero();
+
+	const size_t W = X._cols;
+	int64_t v;
+	for (typename Sparse::ConstIndexedIterator it = S.IndexedBegin(); it != S.IndexedEnd(); ++it) {
+		S.field().convert(v, it.value());
+		v %= 3;
+		if (v == 0) continue;
+		axpyinRow(row(Y, it.rowIndex()), row(X, it.colIndex()), (v == 2) || (v == -1), 0, W, ~Word_T(0));
+	}
+	return Y;
+}
+
+template<class _Field,class _WordT>
+template <class Gettable>
+inline typename MatrixDomain<SlicedField<_Field,_WordT> >::Matrix&
+MatrixDomain<SlicedField<_Field,_WordT> >::copy (Matrix& A, const Gettable& S)
+{
+	A.init(S.rowdim(), S.coldim());
+	A.zero();
+
+	typename Gettable::Field::Element e;
+	int64_t v;
+	Element x;
+	for (size_t i = 0; i < S.rowdim(); ++i)
+		for (size_t j = 0; j < S.coldim(); ++j) {
+			S.field().convert(v, S.getEntry(e, i, j));
+			v %= 3;
+			if (v == 0) continue;
+			A.setEntry(i, j, init(x, (v < 0) ? v+3 : v));
+		}
+	return A;
+}
+
+template<class _Field,class _WordT>
+inline size_t MatrixDomain<SlicedField<_Field,_WordT> >::echelon
+(Matrix& A, std::vector<size_t>& P, std::vector<size_t>& Q, bool storeL)
+{
+	const size_t SIZE = 8*sizeof(Word_T);
+	const size_t m = A.rowdim(), n = A.coldim(), W = A._cols;
+	P.resize(m);
+	Q.resize(n);
+
+	size_t r = 0;
+	for (size_t j = 0; (j < n) && (r < m); ++j) {
+		const size_t w = j / SIZE;
+		const Word_T bit = Word_T(1) << (j % SIZE);
+
+		size_t i = r;
+		while ( (i < m) && !(row(A, i)[w].b0 & bit) ) ++i;
+		if (i == m) continue;
+
+		P[r] = i; Q[r] = j;
+		if (i != r) std::swap_ranges(row(A, i), row(A, i)+W, row(A, r));
+
+		// rows below: y -= (y_j/p) piv on the columns after j
+		const Unit* piv(row(A, r));
+		const bool pivTwo = (piv[w].b1 & bit) != 0;
+		const Word_T mask = ~((bit << 1) - 1);
+		const long lm((long)m);
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(static) if ((m-r)*(W-w) > (1<<14))
+#endif
+		for (long l = (long)r+1; l < lm; ++l) {
+			Unit* y(row(A, (size_t)l));
+			if (!(y[w].b0 & bit)) continue;
+			const bool same = ((y[w].b1 & bit) != 0) == pivTwo;
+			axpyinRow(y, piv, same, w, W, mask);
+			if (storeL && same) y[w].b1 &= ~bit; // multiplier 1
+			else if (storeL) y[w].b1 |= bit;      // multiplier 2
+			else { y[w].b0 &= ~bit; y[w].b1 &= ~bit; }
+		}
+		++r;
+	}
+
+	for (size_t k = r; k < m; ++k) P[k] = k;
+	for (size_t k = r; k < n; ++k) Q[k] = k;
+	return r;
+}
+
+template<class _Field,class _WordT>
+inline typename MatrixDomain<SlicedField<_Field,_WordT> >::Element&
+MatrixDomain<SlicedField<_Field,_WordT> >::detInPlace (Element& d, Matrix& A)
+{
+	linbox_check(A.rowdim() == A.coldim());
+	const size_t SIZE = 8*sizeof(Word_T), n = A.rowdim();
+	std::vector<size_t> P, Q;
+	if (echelon(A, P, Q, false) < n) return init(d, 0);
+
+	// each row exchange and each pivot 2 is a factor -1
+	bool neg = false;
+	for (size_t k = 0; k < n; ++k) {
+		if (P[k] != k) neg = !neg;
+		if (row(A, k)[k / SIZE].b1 & (Word_T(1) << (k % SIZE))) neg = !neg;
+	}
+	return init(d, neg ? 2 : 1);
+}
+
+template<class _Field,class _WordT>
+inline size_t MatrixDomain<SlicedField<_Field,_WordT> >::nullspace (Matrix& N, Matrix& A)
+{
+	const size_t SIZE = 8*sizeof(Word_T);
+	const size_t n = A.coldim(), W = A._cols;
+	std::vector<size_t> P, Q;
+	const size_t r = echelon(A, P, Q, false);
+
+	// reduced row echelon form: unit pivots, zeros above them
+	for (size_t k = r; k-- > 0; ) {
+		const size_t j = Q[k], w = j / SIZE;
+		const Word_T bit = Word_T(1) << (j % SIZE);
+		Unit* piv(row(A, k));
+		if (piv[w].b1 & bit)
+			for (size_t l = w; l < W; ++l) piv[l] *= Word_T(2);
+		for (size_t i = 0; i < k; ++i) {
+			Unit* y(row(A, i));
+			if (y[w].b0 & bit)
+				axpyinRow(y, piv, !(y[w].b1 & bit), w, W, ~Word_T(0));
+		}
+	}
+
+	// one vector per free column f: x_f = 1, x_{Q[k]} = -U[k][f]
+	std::vector<bool> pivot(n, false);
+	for (size_t k = 0; k < r; ++k) pivot[Q[k]] = true;
+	N.init(n, n-r);
+	N.zero();
+	Element one, x;
+	init(one, 1);
+	for (size_t f = 0, t = 0; f < n; ++f) {
+		if (pivot[f]) continue;
+		N.setEntry(f, t, one);
+		for (size_t k = 0; k < r; ++k) {
+			A.getEntry(x, k, f);
+			if (!isZero(x)) N.setEntry(Q[k], t, negin(x));
+		}
+		++t;
+	}
+	return n-r;
+}
+
+}
+
+#endif // __SLICED_DOMAIN_INL
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
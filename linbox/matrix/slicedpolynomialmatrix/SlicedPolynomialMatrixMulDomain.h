@@ -0,0 +1,176 @@
+/* linbox/matrix/slicedpolynomialmatrix/SlicedPolynomialMatrixMulDomain.h
+ * Copyright (C) 2020 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file matrix/slicedpolynomialmatrix/SlicedPolynomialMatrixMulDomain.h
+ * @brief Products of polynomials with matrix coefficients over a prime
+ * field, the kernel of the SlicedPolynomialMatrix multiplications.
+ *
+ * An operand of length \c l with \f$m\times k\f$ coefficients is stored as
+ * \c l contiguous row major slices, i.e. an \f$l \times mk\f$ row major
+ * block (the layout of a <code>PolynomialMatrix<Field,PMType::matfirst></code>).
+ * Two algorithms are provided:
+ * - \c karatsuba: recursive Karatsuba, the three sub-products of the first
+ *   levels being run as parallel tasks.  All the temporaries are taken from
+ *   one scratch buffer allocated before the recursion.
+ * - \c evalinterp: evaluation at \f$0,\dots,L-1\f$ and interpolation by
+ *   products with the Vandermonde matrix and its inverse, one \c fgemm per
+ *   point in between.  It requires a characteristic at least \f$L\f$, the
+ *   length of the product.
+ *
+ * The tasks are FFLAS-FFPACK \c paladin tasks: they run in parallel when
+ * the call is made within a \c PAR_BLOCK.
+ */
+
+#ifndef __LINBOX_matrix_SlicedPolynomialMatrix_SlicedPolynomialMatrixMulDomain_H
+#define __LINBOX_matrix_SlicedPolynomialMatrix_SlicedPolynomialMatrixMulDomain_H
+
+#include <vector>
+#include <fflas-ffpack/fflas/fflas.h>
+#include <fflas-ffpack/ffpack/ffpack.h>
+#include <fflas-ffpack/paladin/parallel.h>
+
+#include "linbox/integer.h"
+#include "linbox/util/error.h"
+#include "linbox/util/debug.h"
+#include "linbox/matrix/densematrix/blas-matrix.h"
+#include "linbox/algorithms/polynomial-matrix/matpoly-thresholds.h"
+
+// Number of Karatsuba levels whose sub-products are run as parallel tasks
+#if !defined(LINBOX_SLICED_PAR_DEPTH)
+#define LINBOX_SLICED_PAR_DEPTH 2
+#endif
+
+// Evaluation/interpolation for products of length up to this value
+#if !defined(LINBOX_SLICED_EVALINTERP_THRESHOLD)
+#define LINBOX_SLICED_EVALINTERP_THRESHOLD 64
+#endif
+
+namespace LinBox
+{
+	template<class _Field>
+	class SlicedPolynomialMatrixMulDomain {
+	public:
+		typedef _Field                               Field;
+		typedef typename Field::Element            Element;
+		typedef typename Field::Element_ptr    Element_ptr;
+		typedef typename Field::ConstElement_ptr ConstElement_ptr;
+		typedef SlicedPolynomialMatrixMulDomain<Field> Self_t;
+
+	protected:
+		const Field* _field;
+		size_t        _leaf;     //!< schoolbook product up to this length
+		size_t        _pardepth; //!< levels of parallel sub-products
+		size_t        _evalmax;  //!< evaluation/interpolation up to this product length
+
+	public:
+		SlicedPolynomialMatrixMulDomain(const Field& F) :
+			_field(&F),
+			_leaf(MatpolyThresholdProfile::profile().forField(F).karaLeaf()),
+			_pardepth(LINBOX_SLICED_PAR_DEPTH),
+			_evalmax(LINBOX_SLICED_EVALINTERP_THRESHOLD)
+		{}
+
+		inline const Field& field() const { return *_field; }
+
+		size_t leaf() const { return _leaf; }
+		void setLeaf(size_t l) { _leaf = std::max(l, size_t(1)); }
+		size_t parallelDepth() const { return _pardepth; }
+		void setParallelDepth(size_t d) { _pardepth = d; }
+		size_t evalInterpThreshold() const { return _evalmax; }
+		void setEvalInterpThreshold(size_t t) { _evalmax = t; }
+
+		//! true if the evaluation/interpolation can compute a product of length \p L
+		bool evalInterpPossible(size_t L) const;
+
+		/*! C = A*B, with evalinterp for short products when possible and karatsuba otherwise.
+		 * \p C has \p la+lb-1 slices of \f$m\times n\f$, \p A \p la slices of
+		 * \f$m\times k\f$ and \p B \p lb slices of \f$k\times n\f$.
+		 */
+		void mul(Element_ptr C, ConstElement_ptr A, size_t la, ConstElement_ptr B, size_t lb,
+				 size_t m, size_t k, size_t n) const;
+
+		//! C = A*B by recursive Karatsuba, same layout as \c mul
+		void karatsuba(Element_ptr C, ConstElement_ptr A, size_t la, ConstElement_ptr B, size_t lb,
+					   size_t m, size_t k, size_t n) const;
+
+		//! C = A*B by evaluation/interpolation, same layout as \c mul
+		void evalinterp(Element_ptr C, ConstElement_ptr A, size_t la, ConstElement_ptr B, size_t lb,
+						size_t m, size_t k, size_t n) const;
+
+		//! C = A*B on vectors of coefficients, \p C is resized
+		template<class Matrix1, class Matrix2, class Matrix3>
+		void mul(std::vector<Matrix1>& C, const std::vector<Matrix2>& A, const std::vector<Matrix3>& B) const
+		{
+			apply(C, A, B, &Self_t::mul);
+		}
+
+		template<class Matrix1, class Matrix2, class Matrix3>
+		void karatsuba(std::vector<Matrix1>& C, const std::vector<Matrix2>& A, const std::vector<Matrix3>& B) const
+		{
+			apply(C, A, B, &Self_t::karatsuba);
+		}
+
+		template<class Matrix1, class Matrix2, class Matrix3>
+		void evalinterp(std::vector<Matrix1>& C, const std::vector<Matrix2>& A, const std::vector<Matrix3>& B) const
+		{
+			apply(C, A, B, &Self_t::evalinterp);
+		}
+
+		//! size of the scratch buffer of \c karatsuba, in elements
+		size_t karatsubaScratch(size_t la, size_t lb, size_t m, size_t k, size_t n) const;
+
+	protected:
+		typedef void (Self_t::*Kernel)(Element_ptr, ConstElement_ptr, size_t, ConstElement_ptr, size_t,
+									   size_t, size_t, size_t) const;
+
+		// copies the coefficients to and from contiguous slices around the kernel
+		template<class Matrix1, class Matrix2, class Matrix3>
+		void apply(std::vector<Matrix1>& C, const std::vector<Matrix2>& A, const std::vector<Matrix3>& B,
+				   Kernel kernel) const;
+
+		// scratch of the balanced recursion on operands of length l
+		size_t scratch(size_t l, size_t sa, size_t sb, size_t sc, size_t depth) const;
+
+		// C[0..la+lb-2] = A*B, schoolbook
+		void naive(Element_ptr C, ConstElement_ptr A, size_t la, ConstElement_ptr B, size_t lb,
+				   size_t m, size_t k, size_t n) const;
+
+		// C[0..2l-2] = A*B, both operands of length l, W of size scratch(l,...)
+		void kara_rec(Element_ptr C, ConstElement_ptr A, ConstElement_ptr B, size_t l,
+					  size_t m, size_t k, size_t n, Element_ptr W, size_t depth) const;
+
+		// V (L x L) Vandermonde matrix of 0,...,L-1 and its inverse iV
+		void vandermonde(Element_ptr V, Element_ptr iV, size_t L) const;
+	};
+
+} // LinBox
+
+#include "SlicedPolynomialMatrixMulDomain.inl"
+
+#endif
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
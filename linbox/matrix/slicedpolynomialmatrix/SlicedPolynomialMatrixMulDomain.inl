@@ -0,0 +1,291 @@
+/* linbox/matrix/slicedpolynomialmatrix/SlicedPolynomialMatrixMulDomain.inl
+ * Copyright (C) 2020 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+#ifndef __LINBOX_matrix_SlicedPolynomialMatrix_SlicedPolynomialMatrixMulDomain_INL
+#define __LINBOX_matrix_SlicedPolynomialMatrix_SlicedPolynomialMatrixMulDomain_INL
+
+namespace LinBox
+{
+	template<class Field>
+	bool SlicedPolynomialMatrixMulDomain<Field>::evalInterpPossible(size_t L) const
+	{
+		integer p;
+		field().characteristic(p);
+		return p >= integer((uint64_t)L);
+	}
+
+	template<class Field>
+	void SlicedPolynomialMatrixMulDomain<Field>::mul(Element_ptr C, ConstElement_ptr A, size_t la,
+													 ConstElement_ptr B, size_t lb,
+													 size_t m, size_t k, size_t n) const
+	{
+		if (la == 0 || lb == 0) return;
+		const size_t L = la+lb-1;
+		if (L <= _evalmax && std::min(la,lb) > 1 && evalInterpPossible(L))
+			evalinterp(C, A, la, B, lb, m, k, n);
+		else
+			karatsuba(C, A, la, B, lb, m, k, n);
+	}
+
+	template<class Field>
+	template<class Matrix1, class Matrix2, class Matrix3>
+	void SlicedPolynomialMatrixMulDomain<Field>::apply(std::vector<Matrix1>& C,
+													   const std::vector<Matrix2>& A,
+													   const std::vector<Matrix3>& B,
+													   Kernel kernel) const
+	{
+		C.clear();
+		if (A.empty() || B.empty()) return;
+		const Field& F = field();
+		const size_t m = A[0].rowdim(), k = A[0].coldim(), n = B[0].coldim();
+		linbox_check(B[0].rowdim() == k);
+		const size_t la = A.size(), lb = B.size(), L = la+lb-1;
+		Element_ptr Ab = FFLAS::fflas_new(F, la*m*k);
+		Element_ptr Bb = FFLAS::fflas_new(F, lb*k*n);
+		Element_ptr Cb = FFLAS::fflas_new(F, L*m*n);
+		for (size_t i = 0; i < la; ++i)
+			FFLAS::fassign(F, m, k, A[i].getPointer(), A[i].getStride(), Ab+i*m*k, k);
+		for (size_t i = 0; i < lb; ++i)
+			FFLAS::fassign(F, k, n, B[i].getPointer(), B[i].getStride(), Bb+i*k*n, n);
+		(this->*kernel)(Cb, Ab, la, Bb, lb, m, k, n);
+		C.reserve(L);
+		for (size_t i = 0; i < L; ++i) {
+			C.emplace_back(F, m, n);
+			FFLAS::fassign(F, m, n, Cb+i*m*n, n, C[i].getPointer(), C[i].getStride());
+		}
+		FFLAS::fflas_delete(Ab, Bb, Cb);
+	}
+
+	template<class Field>
+	size_t SlicedPolynomialMatrixMulDomain<Field>::scratch(size_t l, size_t sa, size_t sb, size_t sc, size_t depth) const
+	{
+		if (l <= _leaf) return 0;
+		const size_t h = (l+1)/2;
+		const size_t child = scratch(h, sa, sb, sc, depth+1);
+		// the three sub-products get their own scratch when they run in parallel
+		return h*(sa+sb) + (2*h-1)*sc + ((depth < _pardepth) ? 3 : 1)*child;
+	}
+
+	template<class Field>
+	size_t SlicedPolynomialMatrixMulDomain<Field>::karatsubaScratch(size_t la, size_t lb, size_t m, size_t k, size_t n) const
+	{
+		const size_t s = std::min(la, lb);
+		if (s <= _leaf) return 0;
+		const size_t sl = (la <= lb) ? k*n : m*k;
+		size_t res = scratch(s, m*k, k*n, m*n, 0);
+		if (la != lb)
+			res += (2*s-1)*m*n + s*sl;
+		return res;
+	}
+
+	template<class Field>
+	void SlicedPolynomialMatrixMulDomain<Field>::naive(Element_ptr C, ConstElement_ptr A, size_t la,
+													   ConstElement_ptr B, size_t lb,
+													   size_t m, size_t k, size_t n) const
+	{
+		const Field& F = field();
+		const size_t sa = m*k, sb = k*n, sc = m*n;
+		for (size_t t = 0; t < la+lb-1; ++t) {
+			const size_t imin = (t+1 < lb) ? 0 : t+1-lb;
+			const size_t imax = std::min(t, la-1);
+			FFLAS::fgemm(F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, m, n, k,
+						 F.one, A+imin*sa, k, B+(t-imin)*sb, n, F.zero, C+t*sc, n);
+			for (size_t i = imin+1; i <= imax; ++i)
+				FFLAS::fgemm(F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, m, n, k,
+							 F.one, A+i*sa, k, B+(t-i)*sb, n, F.one, C+t*sc, n);
+		}
+	}
+
+	template<class Field>
+	void SlicedPolynomialMatrixMulDomain<Field>::kara_rec(Element_ptr C, ConstElement_ptr A, ConstElement_ptr B, size_t l,
+														  size_t m, size_t k, size_t n, Element_ptr W, size_t depth) const
+	{
+		if (l <= _leaf) {
+			naive(C, A, l, B, l, m, k, n);
+			return;
+		}
+		const Field& F = field();
+		const size_t sa = m*k, sb = k*n, sc = m*n;
+		// A = A0 + x^h A1, B = B0 + x^h B1, A1 and B1 of length l1 <= h
+		const size_t h = (l+1)/2, l1 = l-h;
+		Element_ptr As = W;
+		Element_ptr Bs = As + h*sa;
+		Element_ptr P1 = Bs + h*sb;
+		Element_ptr Wr = P1 + (2*h-1)*sc;
+
+		FFLAS::fassign(F, h*sa, A, 1, As, 1);
+		FFLAS::faddin (F, l1*sa, A+h*sa, 1, As, 1);
+		FFLAS::fassign(F, h*sb, B, 1, Bs, 1);
+		FFLAS::faddin (F, l1*sb, B+h*sb, 1, Bs, 1);
+
+		// A0*B0 in C[0..2h-2], A1*B1 in C[2h..2l-2], (A0+A1)*(B0+B1) in P1
+		Element_ptr C0 = C;
+		Element_ptr C2 = C + 2*h*sc;
+		ConstElement_ptr A1 = A + h*sa;
+		ConstElement_ptr B1 = B + h*sb;
+		FFLAS::fzero(F, sc, C+(2*h-1)*sc, 1);
+		if (depth < _pardepth) {
+			const size_t s = scratch(h, sa, sb, sc, depth+1);
+			Element_ptr W0 = Wr, W1 = Wr + s, W2 = Wr + 2*s;
+			SYNCH_GROUP(
+				{ TASK(MODE(VALUE(C0,A,B,W0)),
+					   { kara_rec(C0, A, B, h, m, k, n, W0, depth+1); })}
+				{ TASK(MODE(VALUE(C2,A1,B1,W2)),
+					   { kara_rec(C2, A1, B1, l1, m, k, n, W2, depth+1); })}
+				{ TASK(MODE(VALUE(P1,As,Bs,W1)),
+					   { kara_rec(P1, As, Bs, h, m, k, n, W1, depth+1); })}
+			)
+		}
+		else {
+			kara_rec(C0, A, B, h, m, k, n, Wr, depth+1);
+			kara_rec(C2, A1, B1, l1, m, k, n, Wr, depth+1);
+			kara_rec(P1, As, Bs, h, m, k, n, Wr, depth+1);
+		}
+
+		// C[h..3h-2] += P1 - A0*B0 - A1*B1
+		FFLAS::fsubin(F, (2*h-1)*sc, C0, 1, P1, 1);
+		FFLAS::fsubin(F, (2*l1-1)*sc, C2, 1, P1, 1);
+		FFLAS::faddin(F, (2*h-1)*sc, P1, 1, C+h*sc, 1);
+	}
+
+	template<class Field>
+	void SlicedPolynomialMatrixMulDomain<Field>::karatsuba(Element_ptr C, ConstElement_ptr A, size_t la,
+														   ConstElement_ptr B, size_t lb,
+														   size_t m, size_t k, size_t n) const
+	{
+		if (la == 0 || lb == 0) return;
+		const Field& F = field();
+		const size_t sa = m*k, sb = k*n, sc = m*n;
+		const size_t s = std::min(la, lb);
+		if (s <= _leaf) {
+			naive(C, A, la, B, lb, m, k, n);
+			return;
+		}
+
+		Element_ptr W = FFLAS::fflas_new(F, karatsubaScratch(la, lb, m, k, n));
+		if (la == lb) {
+			kara_rec(C, A, B, la, m, k, n, W, 0);
+			FFLAS::fflas_delete(W);
+			return;
+		}
+
+		// unbalanced: the longest operand is cut in chunks of length s,
+		// the last one being padded with zeros
+		const bool shortA = (la < lb);
+		const size_t ll = shortA ? lb : la;
+		const size_t sl = shortA ? sb : sa;
+		ConstElement_ptr S  = shortA ? A : B;
+		ConstElement_ptr Lg = shortA ? B : A;
+		Element_ptr T   = W + scratch(s, sa, sb, sc, 0);
+		Element_ptr Pad = T + (2*s-1)*sc;
+		FFLAS::fzero(F, (la+lb-1)*sc, C, 1);
+		for (size_t c0 = 0; c0 < ll; c0 += s) {
+			const size_t c = std::min(s, ll-c0);
+			ConstElement_ptr X = Lg + c0*sl;
+			if (c < s) {
+				FFLAS::fassign(F, c*sl, X, 1, Pad, 1);
+				FFLAS::fzero(F, (s-c)*sl, Pad+c*sl, 1);
+				X = Pad;
+			}
+			if (shortA)
+				kara_rec(T, S, X, s, m, k, n, W, 0);
+			else
+				kara_rec(T, X, S, s, m, k, n, W, 0);
+			FFLAS::faddin(F, (c+s-1)*sc, T, 1, C+c0*sc, 1);
+		}
+		FFLAS::fflas_delete(W);
+	}
+
+	template<class Field>
+	void SlicedPolynomialMatrixMulDomain<Field>::vandermonde(Element_ptr V, Element_ptr iV, size_t L) const
+	{
+		const Field& F = field();
+		for (size_t i = 0; i < L; ++i) {
+			Element x, xj;
+			F.init(x, (uint64_t)i);
+			F.assign(xj, F.one);
+			for (size_t j = 0; j < L; ++j) {
+				F.assign(V[i*L+j], xj);
+				F.mulin(xj, x);
+			}
+		}
+		// Invert overwrites its input
+		Element_ptr T = FFLAS::fflas_new(F, L*L);
+		FFLAS::fassign(F, L*L, V, 1, T, 1);
+		int nullity;
+		FFPACK::Invert(F, L, T, L, iV, L, nullity);
+		FFLAS::fflas_delete(T);
+	}
+
+	template<class Field>
+	void SlicedPolynomialMatrixMulDomain<Field>::evalinterp(Element_ptr C, ConstElement_ptr A, size_t la,
+															ConstElement_ptr B, size_t lb,
+															size_t m, size_t k, size_t n) const
+	{
+		if (la == 0 || lb == 0) return;
+		const size_t L = la+lb-1;
+		if (! evalInterpPossible(L))
+			throw LinboxError("LinBox ERROR: characteristic too small for the evaluation/interpolation product.\n");
+		const Field& F = field();
+		const size_t sa = m*k, sb = k*n, sc = m*n;
+
+		Element_ptr V  = FFLAS::fflas_new(F, L*L);
+		Element_ptr iV = FFLAS::fflas_new(F, L*L);
+		Element_ptr EA = FFLAS::fflas_new(F, L*sa);
+		Element_ptr EB = FFLAS::fflas_new(F, L*sb);
+		Element_ptr EC = FFLAS::fflas_new(F, L*sc);
+		vandermonde(V, iV, L);
+
+		// the L evaluations of all the entries at once
+		FFLAS::fgemm(F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, L, sa, la,
+					 F.one, V, L, A, sa, F.zero, EA, sa);
+		FFLAS::fgemm(F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, L, sb, lb,
+					 F.one, V, L, B, sb, F.zero, EB, sb);
+
+		// one product per point
+		SYNCH_GROUP(
+			for (size_t i = 0; i < L; ++i) {
+				ConstElement_ptr Ai = EA + i*sa;
+				ConstElement_ptr Bi = EB + i*sb;
+				Element_ptr      Ci = EC + i*sc;
+				{ TASK(MODE(VALUE(Ai,Bi,Ci) CONSTREFERENCE(F)),
+					   { FFLAS::fgemm(F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, m, n, k,
+									  F.one, Ai, k, Bi, n, F.zero, Ci, n); })}
+			}
+		)
+
+		FFLAS::fgemm(F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, L, sc, L,
+					 F.one, iV, L, EC, sc, F.zero, C, sc);
+
+		FFLAS::fflas_delete(V, iV, EA, EB, EC);
+	}
+
+} // LinBox
+
+#endif
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
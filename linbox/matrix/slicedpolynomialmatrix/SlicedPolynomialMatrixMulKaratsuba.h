@@ -1,22 +1,30 @@
 #ifndef __LINBOX_matrix_SlicedPolynomialMatrix_SlicedPolynomialMatrixMulKaratsuba_H
 #define __LINBOX_matrix_SlicedPolynomialMatrix_SlicedPolynomialMatrixMulKaratsuba_H
 
-#include "SlicedPolynomialMatrix.h"
-#include "SlicedPolynomialMatrixAddSub.h"
+#include <vector>
+#include "linbox/matrix/densematrix/blas-matrix.h"
+#include "SlicedPolynomialMatrixMulDomain.h"
 
 namespace LinBox
 { 
+	/* The operands are sliced matrices over GF(p^e) = GF(p)[x]/(irreducible),
+	 * such as SlicedPolynomialMatrix: they provide IntField, polynomial,
+	 * irreducible, fieldF(), length(), rowdim(), coldim(),
+	 * getMatrixCoefficient(l) and setMatrixCoefficient(l, M).
+	 */
 	template< class Field, class Operand1, class Operand2, class Operand3>
 	class SlicedPolynomialMatrixMulKaratsuba
 	{
 	private:
-		typedef Operand1::IntField IntField;
+		typedef typename Operand1::IntField IntField;
 		typedef BlasMatrix<IntField> Matrix;
-		typedef std::vector<BlasMatrix<Operand1::IntField>> vec;
-		typedef Operand1::polynomial polynomial;
-		vec& modulo(vec& C, int n, polynomial irreducible);
-		vec& karatsuba(IntField& F, vec& A, vec& B, vec& C);
+		typedef std::vector<Matrix> vec;
+		typedef typename Operand1::polynomial polynomial;
+		vec& modulo(vec& C, size_t n, const polynomial& irreducible) const;
 	public:
+		/* C = A*B, the product of the matrix-coefficients being a recursive
+		 * Karatsuba with parallel sub-products (see SlicedPolynomialMatrixMulDomain).
+		 */
 		Operand1 &operator() (const Field &GF, Operand1 &C, const Operand2 &A, const Operand3 &B) const;
 	}; 
 } /* end of namespace LinBox */
@@ -1,26 +1,28 @@
 #ifndef __LINBOX_matrix_SlicedPolynomialMatrix_SlicedPolynomialMatrixMulToomCook_H
 #define __LINBOX_matrix_SlicedPolynomialMatrix_SlicedPolynomialMatrixMulToomCook_H
 
-#include "SlicedPolynomialMatrix.h"
+#include "linbox/matrix/densematrix/blas-matrix.h"
+#include "SlicedPolynomialMatrixMulDomain.h"
 
 namespace LinBox
 { 
+	/* Same operands as SlicedPolynomialMatrixMulKaratsuba, C also
+	 * provides setEntry(l, i, j, a).
+	 */
 	template< class Field, class Vector3, class Vector1, class Vector2>
 	class SlicedPolynomialMatrixMulToomCook
 	{
 	private:
-		typedef SlicedPolynomialMatrixtoBlasMatrix<Field, Vector1::Rep, Vector1::MatrixElement, Vector1::IntField, Vector1::Rep> conversionAtoAm;
-		typedef SlicedPolynomialMatrixtoBlasMatrix<Field, Vector2::Rep, Vector2::MatrixElement, Vector2::IntField, Vector2::Rep> conversionBtoBm;
-		typedef Vector3::IntField IntField;
+		typedef typename Vector3::IntField IntField;
 		typedef BlasMatrix<IntField> Matrix;
-		typedef BlasMatrixtoSlicedPolynomialMatrix<Vector3::IntField, Vector3::Rep, Field, Vector3::Rep, Vector3::MatrixElement> conversionCmtoC;
-		typedef Vector3::polynomial polynomial;
-		Matrix& EvaluationInterpolationMatrices (Matrix& TC, Matrix& iTC);
-		template<class Field, class Vector3, class Vector1, class Vector2>
-		Matrix& mul (IntField& F, Matrix& CMatBloc, const Matrix& AMatBloc, const Matrix& BMatBloc,
-								   const size_t m, const size_t k, const size_t n, const size_t e, polynomial irreducible);
+		typedef typename Vector3::polynomial polynomial;
 	public:
-		Operand1 &operator() (const Field &GF, Operand1 &C, const Operand2 &A, const Operand3 &B) const;
+		/* C = A*B, the matrix-coefficients being multiplied by evaluation at
+		 * 2e-1 points, one fgemm per point, and interpolation
+		 * (see SlicedPolynomialMatrixMulDomain::evalinterp), or by Karatsuba
+		 * when the characteristic is smaller than 2e-1.
+		 */
+		Vector3 &operator() (const Field &GF, Vector3 &C, const Vector1 &A, const Vector2 &B) const;
 	}; 
 } /* end of namespace LinBox */
 
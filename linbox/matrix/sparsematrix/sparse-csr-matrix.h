@@ -827,14 +827,10 @@ namespace LinBox {
 
 
 			// std::cout << "apply" << std::endl;
-			FieldAXPY<Field> accu(field());
-			for (size_t i = 0 ; i < _rownb ; ++i) {
-				accu.reset();
-				for (index_t k = _start[i] ; k < _start[i+1] ; ++k)
-					// field().axpyin( y[i], _data[k], x[_colid[k]] ); //! @todo delay !!!
-					accu.mulacc(_data[k],x[_colid[k]]);
-				accu.get(y[i]);
-			}
+			SparseRowDot<Field> dot(field());
+			for (size_t i = 0 ; i < _rownb ; ++i)
+				dot(y[i], _data.begin()+_start[i], _colid.begin()+_start[i],
+				    (size_t)(_start[i+1]-_start[i]), x);
 
 			return y;
 		}
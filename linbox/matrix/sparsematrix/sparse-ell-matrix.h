@@ -772,18 +772,11 @@ namespace LinBox
 			prepare(field(),y,a);
 
 
-			FieldAXPY<Field> accu(field());
-			for (size_t i = 0 ; i < _rownb ; ++i) {
-				accu.reset();
-				for (size_t k = 0   ; k < _maxc ; ++k)
-					if (!field().isZero(getData(i,k)))
-						// field().axpyin( y[i], getData(i,k), x[getColid(i,k)] ); //! @todo delay !!!
-						accu.mulacc( getData(i,k), x[getColid(i,k)] );
-					else {
-						break;
-					}
-				accu.get(y[i]);
-			}
+			// the padding (zero, column 0) adds nothing: whole rows are
+			// summed, without testing the entries
+			SparseRowDot<Field> dot(field());
+			for (size_t i = 0 ; i < _rownb ; ++i)
+				dot(y[i], _data.begin()+i*_maxc, _colid.begin()+i*_maxc, _maxc, x);
 
 			return y;
 		}
@@ -787,14 +787,9 @@ namespace LinBox
 			prepare(field(),y,a);
 
 
-			FieldAXPY<Field> accu(field());
-			for (size_t i = 0 ; i < _rownb ; ++i) {
-				accu.reset();
-				for (size_t k = 0   ; k < _rowid[i] ; ++k)
-					// field().axpyin( y[i], getData(i,k), x[getColid(i,k)] ); //! @todo delay !!!
-					accu.mulacc( getData(i,k), x[getColid(i,k)] );
-				accu.get(y[i]);
-			}
+			SparseRowDot<Field> dot(field());
+			for (size_t i = 0 ; i < _rownb ; ++i)
+				dot(y[i], _data.begin()+i*_maxc, _colid.begin()+i*_maxc, _rowid[i], x);
 
 			return y;
 		}
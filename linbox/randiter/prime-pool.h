@@ -0,0 +1,291 @@
+/* linbox/randiter/prime-pool.h
+ * Copyright (C) 2019 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file randiter/prime-pool.h
+ * @ingroup randiter
+ * @brief Process-wide pools of pregenerated primes and their fields.
+ */
+
+#ifndef __LINBOX_prime_pool_H
+#define __LINBOX_prime_pool_H
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <map>
+#include <memory>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <givaro/givintprime.h>
+#include <givaro/modular.h>
+
+#include "linbox/integer.h"
+#include "linbox/util/debug.h"
+#include "linbox/randiter/random-prime.h"
+
+// Number of primes generated when a pool is created
+#if !defined(LINBOX_DEFAULT_PRIME_POOL_SIZE)
+#define LINBOX_DEFAULT_PRIME_POOL_SIZE 256
+#endif
+
+// Directory of the primes-<bits>.txt files installed by the build
+#if !defined(LINBOX_PRIME_POOL_DIR) && defined(__LINBOX_PRIME_POOL_DIR)
+#define LINBOX_PRIME_POOL_DIR __LINBOX_PRIME_POOL_DIR
+#endif
+
+namespace LinBox
+{
+
+	/*! @brief Pool of primes of a given bit size.
+	 * @ingroup primes
+	 *
+	 * There is one pool per bit size and field type in the process, see
+	 * \c pool(). A pool holds the primes of \p bits bits in decreasing order
+	 * (the sequence of the deterministic PrimeIterator), each with its field
+	 * already constructed.  Entries are never moved once published, so that
+	 * they can be read without locking; the pool only takes a lock when it
+	 * has to grow.
+	 *
+	 * If \c LINBOX_PRIME_POOL_DIR is defined, a new pool first loads the
+	 * primes of <code>LINBOX_PRIME_POOL_DIR/primes-<bits>.txt</code> when
+	 * this file exists, such a file being written by \c write(). The build
+	 * generates these files with <code>prime-pool-gen</code> for the bit
+	 * sizes used with <code>Modular<double></code> and installs them in
+	 * <code>$(pkgdatadir)</code>, which is the default value of
+	 * \c LINBOX_PRIME_POOL_DIR.
+	 */
+	template<class Field = Givaro::Modular<double> >
+	class PrimePool {
+	public:
+		typedef integer Prime_Type;
+
+		//! a prime and its field
+		struct Entry {
+			Prime_Type prime;
+			Field field;
+			Entry(const Prime_Type& p) : prime(p), field(p) {}
+		};
+
+	protected:
+		static const size_t BlockSize = 1024;
+		static const size_t MaxBlocks = 1024;
+
+		const uint64_t            _bits;
+		std::atomic<size_t>       _size;   //!< number of published entries
+		std::atomic<std::vector<Entry>*> _blocks[MaxBlocks];
+		std::mutex                _mutex;  //!< taken to grow the pool
+		Prime_Type                _last;   //!< smallest prime in the pool
+		Givaro::IntPrimeDom       _IPD;
+
+		PrimePool(uint64_t bits) :
+			_bits(bits), _size(0), _last(Prime_Type(1)<<bits)
+		{
+			linbox_check(bits > 1);
+			for (auto& b : _blocks) b.store(nullptr, std::memory_order_relaxed);
+#ifdef LINBOX_PRIME_POOL_DIR
+			load(std::string(LINBOX_PRIME_POOL_DIR) + "/primes-" + std::to_string(bits) + ".txt");
+#endif
+			reserve(LINBOX_DEFAULT_PRIME_POOL_SIZE);
+		}
+
+		// precond: _mutex is held
+		void publish(const Prime_Type& p)
+		{
+			const size_t n = _size.load(std::memory_order_relaxed);
+			if (n == BlockSize*MaxBlocks)
+				throw LinboxError("LinBox ERROR: prime pool is full.\n");
+			std::vector<Entry>* b = _blocks[n/BlockSize].load(std::memory_order_relaxed);
+			if (b == nullptr) {
+				b = new std::vector<Entry>;
+				b->reserve(BlockSize);
+				_blocks[n/BlockSize].store(b, std::memory_order_release);
+			}
+			b->emplace_back(p);
+			_last = p;
+			_size.store(n+1, std::memory_order_release);
+		}
+
+	public:
+		PrimePool(const PrimePool&) = delete;
+		PrimePool& operator=(const PrimePool&) = delete;
+
+		~PrimePool()
+		{
+			for (auto& b : _blocks) delete b.load(std::memory_order_relaxed);
+		}
+
+		//! The pool of primes of \p bits bits, created on first use.
+		static PrimePool& pool(uint64_t bits)
+		{
+			static std::mutex m;
+			static std::map<uint64_t, std::unique_ptr<PrimePool> > pools;
+			std::lock_guard<std::mutex> lock(m);
+			std::unique_ptr<PrimePool>& p = pools[bits];
+			if (! p) p.reset(new PrimePool(bits));
+			return *p;
+		}
+
+		uint64_t bits() const { return _bits; }
+
+		//! number of primes available without growing
+		size_t size() const { return _size.load(std::memory_order_acquire); }
+
+		//! Makes sure there are at least \p n primes in the pool.
+		void reserve(size_t n)
+		{
+			if (size() >= n) return;
+			std::lock_guard<std::mutex> lock(_mutex);
+			while (_size.load(std::memory_order_relaxed) < n) {
+				Prime_Type p(_last);
+				_IPD.prevprimein(p);
+				if (p.bitsize() < _bits)
+					throw LinboxError("LinBox ERROR: Ran out of primes in prime pool.\n");
+				publish(p);
+			}
+		}
+
+		//! The \p i-th entry, the pool grows if needed.
+		const Entry& operator[] (size_t i)
+		{
+			if (i >= size()) reserve(std::max(i+1, 2*size()));
+			return (*_blocks[i/BlockSize].load(std::memory_order_acquire))[i%BlockSize];
+		}
+
+		const Prime_Type& prime(size_t i) { return (*this)[i].prime; }
+		const Field& field(size_t i) { return (*this)[i].field; }
+
+		/*! Appends the primes read from \p is.
+		 * Only primes of the right size, smaller than the ones already in
+		 * the pool, are taken, so that the pool stays decreasing.
+		 * The primality is not checked.
+		 * @return the number of primes appended
+		 */
+		size_t load(std::istream& is)
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			size_t n = 0;
+			Prime_Type p;
+			while (is >> p)
+				if (p < _last && p.bitsize() == _bits) {
+					publish(p);
+					++n;
+				}
+			return n;
+		}
+
+		size_t load(const std::string& filename)
+		{
+			std::ifstream is(filename);
+			return is ? load(is) : 0;
+		}
+
+		//! Writes the first \p n primes of the pool, one per line.
+		std::ostream& write(std::ostream& os, size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+				os << prime(i) << '\n';
+			return os;
+		}
+	};
+
+	/*!  @brief  Prime iterator over a PrimePool.
+	 * @ingroup primes
+	 * @ingroup randiter
+	 *
+	 * Drop-in replacement for <code>PrimeIterator<HeuristicTag></code>
+	 * when the same bit size is used over and over: the iterator starts at
+	 * a random position among the primes already in the pool and goes
+	 * through the following ones, never returning a prime twice.
+	 *
+	 * \c operator++ is not thread safe, like for PrimeIterator, but \c next()
+	 * is lock-free (unless the pool has to grow) and can be shared by
+	 * parallel workers.
+	 */
+	template<class Field = Givaro::Modular<double> >
+	class PrimePoolIterator {
+	public:
+		typedef PrimePool<Field> Pool;
+		typedef typename Pool::Prime_Type Prime_Type;
+		typedef typename Pool::Entry Entry;
+		typedef std::true_type UniqueSamplingTag;
+		typedef IteratorCategories::HeuristicTag IteratorTag;
+
+	protected:
+		Pool&               _pool;
+		std::atomic<size_t> _next;
+		const Entry*        _cur;
+
+	public:
+		/*! Constructor.
+		 * @param bits size of primes (in bits).
+		 * @param seed if \c 0 a seed will be generated, otherwise, the
+		 * provided seed will be use.
+		 */
+		PrimePoolIterator(uint64_t bits = 23, uint64_t seed = 0) :
+			_pool(Pool::pool(bits))
+		{
+			if (! seed)
+				seed = BaseTimer::seed();
+			integer::seeding(seed);
+			integer start;
+			integer::random_lessthan(start, integer((uint64_t)_pool.size()));
+			_next.store((size_t)start, std::memory_order_relaxed);
+			_cur = &next();
+		}
+
+		PrimePoolIterator(const PrimePoolIterator& other) :
+			_pool(other._pool), _next(other._next.load()), _cur(other._cur)
+		{}
+
+		//! The next unused entry, safe to call from several threads.
+		const Entry& next()
+		{
+			return _pool[_next.fetch_add(1, std::memory_order_relaxed)];
+		}
+
+		inline PrimePoolIterator& operator ++ ()
+		{
+			_cur = &next();
+			return *this;
+		}
+
+		//! the current prime
+		const Prime_Type &operator * () const { return _cur->prime; }
+
+		//! the field of the current prime
+		const Field& field() const { return _cur->field; }
+
+		uint64_t getBits() const { return _pool.bits(); }
+	};
+
+}
+
+#endif //__LINBOX_prime_pool_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
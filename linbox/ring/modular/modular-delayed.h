@@ -0,0 +1,235 @@
+/* linbox/ring/modular/modular-delayed.h
+ * Copyright (C) 2019 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file ring/modular/modular-delayed.h
+ * @ingroup ring
+ * @brief Delayed reduction kernels for the dot products over
+ * <code>Givaro::Modular</code>.
+ *
+ * The products are accumulated without any reduction and the sum is
+ * reduced once, at the end, or once per block of products:
+ * - 32 bit elements: each 64 bit product is split in two 32 bit halves,
+ *   summed in two 64 bit accumulators which cannot overflow before
+ *   \f$2^{32}\f$ terms.  The loops have no branch and are vectorized by
+ *   the compiler (\c vpmuludq with AVX2 or AVX-512).
+ * - 64 bit elements: the 128 bit products are summed in a 128 bit
+ *   accumulator, \f$2^{128} \bmod p\f$ being added back on overflow.  This
+ *   is correct for any modulus below \f$2^{64}\f$, whereas a 64 bit
+ *   accumulator is only correct below \f$2^{32}\f$.
+ * - \c double and \c float elements: the sum is exact as long as it fits
+ *   in the mantissa, hence \f$\lfloor (2^{53}-p)/(p-1)^2 \rfloor\f$
+ *   (resp. \f$2^{24}\f$) products of residues can be added to a residue
+ *   before the \c fmod.  Within a block the loop has no branch and, with
+ *   OpenMP SIMD, is vectorized with gathers for the indexed accesses.
+ */
+
+#ifndef __LINBOX_modular_delayed_H
+#define __LINBOX_modular_delayed_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <givaro/givconfig.h>
+
+namespace LinBox { namespace Protected {
+
+	//! \f$(hi \cdot 2^{32} + lo) \bmod p\f$, for \f$p < 2^{32}\f$
+	inline uint64_t reduceSplit32(uint64_t lo, uint64_t hi, uint64_t p)
+	{
+		const uint64_t two32 = (uint64_t(1) << 32) % p;
+		return ((hi % p) * two32 + lo % p) % p;
+	}
+
+	//! dense dot product of 32 bit residues modulo \p p
+	template <class Vector1, class Vector2>
+	inline uint64_t dotDelayed32(const Vector1& v1, const Vector2& v2, uint64_t p)
+	{
+		const size_t n = v1.size();
+		uint64_t lo = 0, hi = 0;
+		for (size_t k = 0; k < n; ++k) {
+			const uint64_t t = (uint64_t)v1[k] * (uint64_t)v2[k];
+			lo += t & 0xFFFFFFFFu;
+			hi += t >> 32;
+		}
+		return reduceSplit32(lo, hi, p);
+	}
+
+	//! dot product of a sparse parallel vector and a dense one, 32 bit residues
+	template <class Vector1, class Vector2>
+	inline uint64_t dotDelayed32Sparse(const Vector1& v1, const Vector2& v2, uint64_t p)
+	{
+		const size_t n = v1.first.size();
+		uint64_t lo = 0, hi = 0;
+		for (size_t k = 0; k < n; ++k) {
+			const uint64_t t = (uint64_t)v1.second[k] * (uint64_t)v2[v1.first[k]];
+			lo += t & 0xFFFFFFFFu;
+			hi += t >> 32;
+		}
+		return reduceSplit32(lo, hi, p);
+	}
+
+#ifdef __GIVARO_HAVE_INT128
+	typedef unsigned __int128 uint128_acc;
+
+	//! \f$2^{128} \bmod p\f$
+	inline uint128_acc twoPow128Mod(uint64_t p)
+	{
+		const uint128_acc t = (uint128_acc(1) << 64) % p;
+		return (t * t) % p;
+	}
+
+	//! y += a*x, with the overflow folded back
+	inline uint128_acc& mulacc128(uint128_acc& y, uint64_t a, uint64_t x, const uint128_acc& two128)
+	{
+		const uint128_acc t = (uint128_acc)a * x;
+		y += t;
+		if (y < t) y += two128;
+		return y;
+	}
+
+	//! dense dot product of 64 bit residues modulo \p p
+	template <class Vector1, class Vector2>
+	inline uint64_t dotDelayed64(const Vector1& v1, const Vector2& v2, uint64_t p, const uint128_acc& two128)
+	{
+		const size_t n = v1.size();
+		uint128_acc y = 0;
+		for (size_t k = 0; k < n; ++k)
+			mulacc128(y, (uint64_t)v1[k], (uint64_t)v2[k], two128);
+		return (uint64_t)(y % p);
+	}
+
+	//! dot product of a sparse parallel vector and a dense one, 64 bit residues
+	template <class Vector1, class Vector2>
+	inline uint64_t dotDelayed64Sparse(const Vector1& v1, const Vector2& v2, uint64_t p, const uint128_acc& two128)
+	{
+		const size_t n = v1.first.size();
+		uint128_acc y = 0;
+		for (size_t k = 0; k < n; ++k)
+			mulacc128(y, (uint64_t)v1.second[k], (uint64_t)v2[v1.first[k]], two128);
+		return (uint64_t)(y % p);
+	}
+#endif
+
+	/*! @brief Delayed reduction policy of a floating point Modular field.
+	 * The mantissa size is known at compile time; the block size, number
+	 * of products summed between two reductions, depends on the modulus.
+	 */
+	template <class Element>
+	struct DelayedFloatPolicy {
+		static constexpr int mantissa = std::numeric_limits<Element>::digits;
+
+		//! number of products of residues that can be added exactly to a residue
+		static size_t blockSize(Element p)
+		{
+			const double m1 = (double)p - 1.;
+			if (m1 <= 1.) return std::numeric_limits<size_t>::max();
+			const double n = std::floor((std::ldexp(1., mantissa) - (double)p) / (m1*m1));
+			if (n < 1.) return 1;
+			return (n < (double)std::numeric_limits<size_t>::max()) ? (size_t)n : std::numeric_limits<size_t>::max();
+		}
+	};
+
+	//! sum_k val[k] x[col[k]] mod p, reduced once every \p block products
+	template <class Element, class ValIterator, class ColIterator, class Vector>
+	inline Element dotDelayedFloat(ValIterator val, ColIterator col, size_t n, const Vector& x, Element p, size_t block)
+	{
+		Element y = 0;
+		for (size_t k = 0; k < n; ) {
+			const size_t e = (n - k > block) ? k + block : n;
+			Element s = y;
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp simd reduction(+:s)
+#endif
+			for (size_t j = k; j < e; ++j)
+				s += val[j] * x[col[j]];
+			y = std::fmod(s, p);
+			k = e;
+		}
+		return y;
+	}
+
+	//! sum of it->second x[it->first] mod p over \p n pairs, reduced once every \p block products
+	template <class Element, class PairIterator, class Vector>
+	inline Element dotDelayedFloatPairs(PairIterator it, size_t n, const Vector& x, Element p, size_t block)
+	{
+		Element y = 0;
+		for (size_t k = 0; k < n; ) {
+			const size_t e = (n - k > block) ? k + block : n;
+			Element s = y;
+			for (size_t j = k; j < e; ++j, ++it)
+				s += it->second * x[it->first];
+			y = std::fmod(s, p);
+			k = e;
+		}
+		return y;
+	}
+
+	/*! @brief SparseRowDot for the floating point Modular fields.
+	 * Base class of the specializations in modular-double.h and
+	 * modular-float.h.
+	 */
+	template <class Field>
+	class DelayedFloatRowDot {
+	public:
+		typedef typename Field::Element Element;
+		typedef DelayedFloatPolicy<Element> Policy;
+
+		DelayedFloatRowDot(const Field& F) :
+			_field(&F), _p(F.fcharacteristic()), _block(Policy::blockSize(_p))
+		{}
+
+		template <class ValIterator, class ColIterator, class Vector>
+		inline Element& operator() (Element& y, ValIterator val, ColIterator col, size_t n, const Vector& x) const
+		{
+			return y = dotDelayedFloat(val, col, n, x, _p, _block);
+		}
+
+		template <class PairIterator, class Vector>
+		inline Element& pairs(Element& y, PairIterator it, size_t n, const Vector& x) const
+		{
+			return y = dotDelayedFloatPairs(it, n, x, _p, _block);
+		}
+
+		inline const Field& field() const { return *_field; }
+
+		//! number of products between two reductions
+		size_t blockSize() const { return _block; }
+
+	protected:
+		const Field* _field;
+		Element _p;
+		size_t _block;
+	};
+
+} } // LinBox::Protected
+
+#endif // __LINBOX_modular_delayed_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -43,6 +43,7 @@
 #include "linbox/ring/modular.h"
 #include "linbox/field/field-traits.h"
 #include "linbox/util/field-axpy.h"
+#include "linbox/ring/modular/modular-delayed.h"
 #include "linbox/util/debug.h"
 
 #include "linbox/util/write-mm.h"
@@ -149,6 +150,15 @@ namespace LinBox
 		double _bound;
 	};
 
+	//! Sparse rows: one reduction per block of products, see modular-delayed.h
+	template <>
+	class SparseRowDot<Givaro::Modular<double> > : public Protected::DelayedFloatRowDot<Givaro::Modular<double> > {
+	public:
+		SparseRowDot (const Givaro::Modular<double> &F) :
+			Protected::DelayedFloatRowDot<Givaro::Modular<double> > (F)
+		{}
+	};
+
 	template <>
 	class DotProductDomain<Givaro::Modular<double> > : public  VectorDomainBase<Givaro::Modular<double> > {
 	private:
@@ -49,6 +49,7 @@
 #include "linbox/ring/modular.h"
 #include "linbox/field/field-traits.h"
 #include "linbox/util/field-axpy.h"
+#include "linbox/ring/modular/modular-delayed.h"
 #include "linbox/util/debug.h"
 #include "linbox/field/field-traits.h"
 
@@ -118,6 +119,15 @@ namespace LinBox
 	};
 
 
+	//! Sparse rows: one reduction per block of products, see modular-delayed.h
+	template <>
+	class SparseRowDot<Givaro::Modular<float> > : public Protected::DelayedFloatRowDot<Givaro::Modular<float> > {
+	public:
+		SparseRowDot (const Givaro::Modular<float> &F) :
+			Protected::DelayedFloatRowDot<Givaro::Modular<float> > (F)
+		{}
+	};
+
 	template <>
 	class DotProductDomain<Givaro::Modular<float> > : public VectorDomainBase<Givaro::Modular<float> > {
 	private:
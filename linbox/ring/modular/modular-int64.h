@@ -38,6 +38,7 @@
 #include "linbox/field/field-traits.h"
 #include "linbox/util/debug.h"
 #include "linbox/field/field-traits.h"
+#include "linbox/ring/modular/modular-delayed.h"
 
 #include <givaro/modular-integral.h>
 
@@ -66,15 +67,27 @@ namespace LinBox
 
 		typedef int64_t Element;
 		typedef Givaro::Modular<int64_t,Compute_t> Field;
+#ifdef __GIVARO_HAVE_INT128
+		typedef Protected::uint128_acc Abnormal; // 128 bit products, any modulus
+#else
+		typedef uint64_t Abnormal; // correct for moduli below 2^32 only
+#endif
 
 		FieldAXPY (const Field &F) : _field (&F), _y(0)
 		{
 			_two_64 = (uint64_t(1) << 32) % uint64_t(F.characteristic());
 			_two_64 = (_two_64 * _two_64) % uint64_t(F.characteristic());
+#ifdef __GIVARO_HAVE_INT128
+			_two_128 = Protected::twoPow128Mod (uint64_t(F.characteristic()));
+#endif
 		}
 
 		FieldAXPY (const FieldAXPY &faxpy) :
-			_two_64 (faxpy._two_64), _field (faxpy._field), _y (0)
+			_two_64 (faxpy._two_64),
+#ifdef __GIVARO_HAVE_INT128
+			_two_128 (faxpy._two_128),
+#endif
+			_field (faxpy._field), _y (0)
 		{}
 
 		FieldAXPY<Field> &operator = (const FieldAXPY &faxpy)
@@ -82,12 +95,30 @@ namespace LinBox
 			_field = faxpy._field;
 			_y = faxpy._y;
 			_two_64 = faxpy._two_64;
+#ifdef __GIVARO_HAVE_INT128
+			_two_128 = faxpy._two_128;
+#endif
 			return *this;
 		}
 
 		inline const Field & field() const { return *_field; }
 
-		inline uint64_t& mulacc (const Element &a, const Element &x)
+#ifdef __GIVARO_HAVE_INT128
+		inline Abnormal& mulacc (const Element &a, const Element &x)
+		{
+			return Protected::mulacc128 (_y, (uint64_t) a, (uint64_t) x, _two_128);
+		}
+
+		inline Abnormal& accumulate (const Element &t)
+		{
+			_y += (uint64_t)t;
+			if (_y < (uint64_t)t)
+				return _y += _two_128;
+			else
+				return _y;
+		}
+#else
+		inline Abnormal& mulacc (const Element &a, const Element &x)
 		{
 			uint64_t t = (uint64_t) a * (uint64_t) x;
 			_y += t;
@@ -97,7 +128,7 @@ namespace LinBox
 				return _y;
 		}
 
-		inline uint64_t& accumulate (const Element &t)
+		inline Abnormal& accumulate (const Element &t)
 		{
 			_y += (uint64_t)t;
 			if (_y < (uint64_t)t)
@@ -105,6 +136,7 @@ namespace LinBox
 			else
 				return _y;
 		}
+#endif
 
 		inline Element& get (Element &y)
 		{
@@ -125,10 +157,13 @@ namespace LinBox
 
 	public:
 		uint64_t _two_64;
+#ifdef __GIVARO_HAVE_INT128
+		Abnormal _two_128;
+#endif
 
 	protected:
 		const Field *_field;
-		uint64_t _y;
+		Abnormal _y;
 	};
 
 
@@ -150,7 +185,9 @@ namespace LinBox
 		template <class Vector1, class Vector2>
 		inline Element &dotSpecializedDD (Element &res, const Vector1 &v1, const Vector2 &v2) const
 		{
-
+#ifdef __GIVARO_HAVE_INT128
+			return res = (Element) Protected::dotDelayed64 (v1, v2, (uint64_t) field().characteristic(), faxpy()._two_128);
+#else
 			typename Vector1::const_iterator i;
 			typename Vector2::const_iterator j;
 
@@ -168,12 +205,15 @@ namespace LinBox
 
 			y %= (uint64_t) field().characteristic();
 			return res = (Element)y;
-
+#endif
 		}
 
 		template <class Vector1, class Vector2>
 		inline Element &dotSpecializedDSP (Element &res, const Vector1 &v1, const Vector2 &v2) const
 		{
+#ifdef __GIVARO_HAVE_INT128
+			return res = (Element) Protected::dotDelayed64Sparse (v1, v2, (uint64_t) field().characteristic(), faxpy()._two_128);
+#else
 			typename Vector1::first_type::const_iterator i_idx;
 			typename Vector1::second_type::const_iterator i_elt;
 
@@ -193,6 +233,7 @@ namespace LinBox
 			y %= (uint64_t) field().characteristic();
 
 			return res = (Element) y;
+#endif
 		}
 	};
 
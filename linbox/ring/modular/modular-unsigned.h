@@ -45,6 +45,8 @@
 #define __LINBOX_MIN(a,b) ( (a) < (b) ? (a) : (b) )
 #endif
 
+#include "linbox/ring/modular/modular-delayed.h"
+
 namespace LinBox { /*  uint8_t */
 
             /*! Specialization of FieldAXPY for uint8_t modular field */
@@ -915,48 +917,17 @@ namespace LinBox { /*  uint32_t */
 		using VectorDomainBase<Field >::faxpy;
 
 	protected:
+		// branch free, vectorized by the compiler, see modular-delayed.h
 		template <class Vector1, class Vector2>
 		inline Element &dotSpecializedDD (Element &res, const Vector1 &v1, const Vector2 &v2) const
             {
-                typename Vector1::const_iterator i;
-                typename Vector2::const_iterator j;
-
-                uint64_t y = 0;
-                uint64_t t;
-
-                for (i = v1.begin (), j = v2.begin (); i < v1.end (); ++i, ++j) {
-                    t = (uint64_t) *i * (uint64_t) *j;
-                    y += t;
-
-                    if (y < t)
-                        y += faxpy()._two_64;
-                }
-
-                y %= (uint64_t) field().characteristic();
-
-                return res = (uint32_t) y;
+                return res = (uint32_t) Protected::dotDelayed32 (v1, v2, (uint64_t) field().characteristic());
             }
-        
 
 		template <class Vector1, class Vector2>
 		inline Element &dotSpecializedDSP (Element &res, const Vector1 &v1, const Vector2 &v2) const
             {
-                typename Vector1::first_type::const_iterator i_idx;
-                typename Vector1::second_type::const_iterator i_elt;
-
-                uint64_t y = 0;
-                uint64_t t = 0;
-
-                for (i_idx = v1.first.begin (), i_elt = v1.second.begin (); i_idx != v1.first.end (); ++i_idx, ++i_elt) {
-                    t = (uint64_t) *i_elt * (uint64_t) v2[*i_idx];
-                    y += t;
-                    if (y < t)
-                        y += faxpy()._two_64;
-                }
-
-                y %= (uint64_t) field().characteristic();
-
-                return res = (uint32_t)y;
+                return res = (uint32_t) Protected::dotDelayed32Sparse (v1, v2, (uint64_t) field().characteristic());
             }
 
         
@@ -1167,26 +1138,58 @@ namespace LinBox { /*  uint64_t */
 
 		typedef uint64_t Element;
 		typedef Givaro::Modular<uint64_t,Compute_t> Field;
+#ifdef __GIVARO_HAVE_INT128
+		typedef Protected::uint128_acc Abnormal; // 128 bit products, any modulus
+#else
+		typedef uint64_t Abnormal; // correct for moduli below 2^32 only
+#endif
 
 		FieldAXPY (const Field &F) :
                 _field (&F), _y(0)
             {
                 _two_64 = (uint64_t(1) << 32) % uint64_t(F.characteristic());
                 _two_64 = (_two_64 * _two_64) % uint64_t(F.characteristic());
+#ifdef __GIVARO_HAVE_INT128
+                _two_128 = Protected::twoPow128Mod (uint64_t(F.characteristic()));
+#endif
             }
 
 		FieldAXPY (const FieldAXPY &faxpy) :
-                _two_64 (faxpy._two_64), _field (faxpy._field), _y (0)
+                _two_64 (faxpy._two_64),
+#ifdef __GIVARO_HAVE_INT128
+                _two_128 (faxpy._two_128),
+#endif
+                _field (faxpy._field), _y (0)
             {}
 
 		FieldAXPY<Field > &operator = (const FieldAXPY &faxpy)
             {
                 _field = faxpy._field;
                 _y = faxpy._y;
+                _two_64 = faxpy._two_64;
+#ifdef __GIVARO_HAVE_INT128
+                _two_128 = faxpy._two_128;
+#endif
                 return *this;
             }
 
-		inline uint64_t& mulacc (const Element &a, const Element &x)
+#ifdef __GIVARO_HAVE_INT128
+		inline Abnormal& mulacc (const Element &a, const Element &x)
+            {
+                return Protected::mulacc128 (_y, a, x, _two_128);
+            }
+
+		inline Abnormal& accumulate (const Element &t)
+            {
+                _y += t;
+
+                if (_y < t)
+                    return _y += _two_128;
+                else
+                    return _y;
+            }
+#else
+		inline Abnormal& mulacc (const Element &a, const Element &x)
             {
                 uint64_t t = (uint64_t) a * (uint64_t) x;
                 _y += t;
@@ -1197,7 +1200,7 @@ namespace LinBox { /*  uint64_t */
                     return _y;
             }
 
-		inline uint64_t& accumulate (const Element &t)
+		inline Abnormal& accumulate (const Element &t)
             {
                 _y += t;
 
@@ -1206,8 +1209,9 @@ namespace LinBox { /*  uint64_t */
                 else
                     return _y;
             }
+#endif
 
-		inline uint64_t& accumulate_special (const Element &t)
+		inline Abnormal& accumulate_special (const Element &t)
             {
                 return _y += t;
             }
@@ -1215,7 +1219,6 @@ namespace LinBox { /*  uint64_t */
 		inline Element &get (Element &y) const
             {
                 const_cast<FieldAXPY<Field>*>(this)->_y %= (uint64_t) field().characteristic();
-                    //if ((int64_t) _y < 0) const_cast<FieldAXPY<Field>*>(this)->_y += field().characteristic();
                 return y = (uint64_t) _y;
             }
 
@@ -1234,11 +1237,14 @@ namespace LinBox { /*  uint64_t */
 	public:
 	
 		uint64_t _two_64;
+#ifdef __GIVARO_HAVE_INT128
+		Abnormal _two_128;
+#endif
 		
 	private:
 
 		const Field *_field;
-		uint64_t _y;
+		Abnormal _y;
 	};
 
         //! Specialization of DotProductDomain for uint64_t modular field
@@ -1261,7 +1267,9 @@ namespace LinBox { /*  uint64_t */
 		template <class Vector1, class Vector2>
             inline Element &dotSpecializedDD (Element &res, const Vector1 &v1, const Vector2 &v2) const
         {
-
+#ifdef __GIVARO_HAVE_INT128
+			return res = (Element) Protected::dotDelayed64 (v1, v2, (uint64_t) field().characteristic(), faxpy()._two_128);
+#else
 			typename Vector1::const_iterator i;
 			typename Vector2::const_iterator j;
 
@@ -1279,12 +1287,15 @@ namespace LinBox { /*  uint64_t */
 
 			y %= (uint64_t) field().characteristic();
 			return res = (Element)y;
-
+#endif
 		}
 
 		template <class Vector1, class Vector2>
             inline Element &dotSpecializedDSP (Element &res, const Vector1 &v1, const Vector2 &v2) const
 		{
+#ifdef __GIVARO_HAVE_INT128
+			return res = (Element) Protected::dotDelayed64Sparse (v1, v2, (uint64_t) field().characteristic(), faxpy()._two_128);
+#else
 			typename Vector1::first_type::const_iterator i_idx;
 			typename Vector1::second_type::const_iterator i_elt;
 
@@ -1304,6 +1315,7 @@ namespace LinBox { /*  uint64_t */
 			y %= (uint64_t) field().characteristic();
 
 			return res = (Element) y;
+#endif
 		}	
 
         
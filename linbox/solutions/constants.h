@@ -38,6 +38,21 @@
 #define LINBOX_DEFAULT_EARLY_TERMINATION_THRESHOLD 10
 #endif
 
+// Per prime time (seconds) under which parallel CRA fills idle threads with speculative primes.
+#if !defined(LINBOX_DEFAULT_CRA_SPECULATIVE_COST)
+#define LINBOX_DEFAULT_CRA_SPECULATIVE_COST 1e-2
+#endif
+
+// Density of the active submatrix above which sparse elimination switches to dense (0 never switches).
+#if !defined(LINBOX_DEFAULT_DENSE_SWITCH_DENSITY)
+#define LINBOX_DEFAULT_DENSE_SWITCH_DENSITY 0.1
+#endif
+
+// Largest Markowitz cost of a weight-2 column merge accepted by structured Gaussian elimination.
+#if !defined(LINBOX_DEFAULT_STRUCTURED_MAX_COST)
+#define LINBOX_DEFAULT_STRUCTURED_MAX_COST 32u
+#endif
+
 // Used to decide which method to use when using Method::Auto on a Blackbox or Sparse matrix.
 #if !defined(LINBOX_USE_BLACKBOX_THRESHOLD)
 #define LINBOX_USE_BLACKBOX_THRESHOLD 1000u
@@ -37,6 +37,7 @@
 #include "linbox/vector/blas-vector.h"
 
 #include "linbox/matrix/dense-matrix.h"
+#include "linbox/matrix/sliced3/sliced-dispatch.h"
 #include "linbox/algorithms/blackbox-container.h"
 #include "linbox/algorithms/blackbox-container-symmetric.h"
 #include "linbox/algorithms/massey-domain.h"
@@ -330,15 +331,13 @@ namespace LinBox
 			throw LinboxError("LinBox ERROR: matrix must be square for determinant computation\n");
 
 		typedef typename Blackbox::Field Field;
-		Field F = A.field();
 
 		commentator().start ("Blas Determinant", "blasdet");
 
 		linbox_check (A.coldim () == A.rowdim ());
 
 		BlasMatrix<Field> B(A);
-		BlasMatrixDomain<Field> BMD(F);
-		d= BMD.detInPlace(B);
+		Protected::blasDetInPlace(d, B);
 		commentator().stop ("done", NULL, "blasdet");
 
 		return d;
@@ -361,7 +360,7 @@ namespace LinBox
 		for(size_t i = 0; i < A.rowdim() ; ++i)
 			for(size_t j = 0; j < A.coldim(); ++j)
 				A1.setEntry(i,j,getEntry(tmp, A, i, j));
-		GaussDomain<Field> GD ( A1.field() );
+		GaussDomain<Field> GD ( A1.field(), Meth.denseSwitchDensity );
 		GD.detInPlace (d, A1, Meth.pivotStrategy);
 		commentator().stop ("done", NULL, "SEDet");
 		return d;
@@ -380,7 +379,7 @@ namespace LinBox
 		commentator().start ("Sparse Elimination Determinant", "SEDet");
 		// We make a copy as these data will be destroyed
 		SparseMatrix<Field, SparseMatrixFormat::SparseSeq> A1 (A);
-		GaussDomain<Field> GD ( A.field() );
+		GaussDomain<Field> GD ( A.field(), Meth.denseSwitchDensity );
 		GD.detInPlace (d, A1, Meth.pivotStrategy);
 		commentator().stop ("done", NULL, "SEDet");
 		return d;
@@ -395,7 +394,7 @@ namespace LinBox
 		if (A.coldim() != A.rowdim())
 			throw LinboxError("LinBox ERROR: matrix must be square for determinant computation\n");
         commentator().start ("Sparse Elimination Determinant in place", "SEDetin", A.rowdim() );
-		GaussDomain<Field> GD ( A.field() );
+		GaussDomain<Field> GD ( A.field(), Meth.denseSwitchDensity );
 		GD.detInPlace (d, A, Meth.pivotStrategy);
         commentator().stop ("done", NULL, "SEDetin");
 		return d;
@@ -499,13 +498,10 @@ namespace LinBox
 		if (A.coldim() != A.rowdim())
 			throw LinboxError("LinBox ERROR: matrix must be square for determinant computation\n");
 
-		Field F = A.field();
-
 		commentator().start ("Determinant", "detInPlace");
 		linbox_check (A.coldim () == A.rowdim ());
 
-		BlasMatrixDomain<Field> BMD(F);
-		d= BMD.detInPlace(static_cast<BlasMatrix<Field>& > (A));
+		Protected::blasDetInPlace(d, A);
 		commentator().stop ("done", NULL, "detInPlace");
 
 		return d;
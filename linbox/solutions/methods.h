@@ -176,6 +176,7 @@ namespace LinBox {
     enum class PivotStrategy {
         None,
         Linear,
+        Structured, //!< Markowitz pre-pass on singleton and weight-2 columns, then Linear.
     };
 
     /**
@@ -215,6 +216,8 @@ namespace LinBox {
 
         // ----- For Elimination-based methods.
         PivotStrategy pivotStrategy = PivotStrategy::Linear;
+        double denseSwitchDensity = LINBOX_DEFAULT_DENSE_SWITCH_DENSITY; //!< Sparse elimination finishes with a dense
+                                                                         //!  factorization above this active density.
 
         // ----- For Dixon method.
         // @fixme SingularSolutionType::Deterministic fails with Dense Dixon
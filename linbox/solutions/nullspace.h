@@ -31,11 +31,36 @@
  * - Dense matrix nullspace on Integers or <code>Z/pZ</code>
  * - Sparse matrix nullspace
  * - Random element in the nullspace
+ *
+ * For now only random nullspace vectors of sparse matrices over GF2
+ * with Method::BlockLanczos are provided.
  */
 
+#include "linbox/field/gf2.h"
+#include "linbox/blackbox/zo-gf2.h"
+#include "linbox/solutions/methods.h"
+#include "linbox/algorithms/block-lanczos-gf2.h"
+
 namespace LinBox
 {
-#error "you don't want to include this file for now."
+	/** Random vectors of the (right) nullspace of a sparse matrix over GF2.
+	 *
+	 * @param N up to 64 independent nullspace vectors, packed:
+	 *          N[j] holds the j-th coordinates, vector k being bit k
+	 * @param A matrix
+	 * @param m method options
+	 * @return the number of vectors found
+	 */
+	inline size_t nullspace (std::vector<uint64_t> &N, const ZeroOne<GF2> &A,
+				 const Method::BlockLanczos &m)
+	{
+		commentator().start ("Block Lanczos nullspace over GF2", "nullspaceGF2");
+		GF2 F2;
+		BlockLanczosGF2 solver (F2, m);
+		const size_t k = solver.sampleNullspace (N, A);
+		commentator().stop ("done", NULL, "nullspaceGF2");
+		return k;
+	}
 }
 
 #endif // __LINBOX_modulardense_nullspace_H
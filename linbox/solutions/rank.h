@@ -45,6 +45,7 @@
 #include "linbox/algorithms/whisart_trace.h"
 #include "linbox/matrix/dense-matrix.h"
 #include "linbox/matrix/matrixdomain/blas-matrix-domain.h"
+#include "linbox/matrix/sliced3/sliced-dispatch.h"
 
 #include "linbox/vector/vector-traits.h"
 #include "linbox/solutions/trace.h"
@@ -423,8 +423,7 @@ namespace LinBox
 		linbox_check( a == b );
 		linbox_check( a < LinBox::BlasBound);
 		BlasMatrix<Field> B(A);
-		BlasMatrixDomain<Field> D(F);
-		r = D.rankInPlace(B);
+		r = Protected::blasRankInPlace(B);
 		commentator().stop ("done", NULL, "blasrank");
 		return r;
 	}
@@ -586,10 +585,10 @@ namespace LinBox { /*  rankInPlace */
 	/// specialization to \f$ \mathbf{F}_2 \f$
 	inline size_t &rankInPlace (size_t                       &r,
 				      GaussDomain<GF2>::Matrix            &A,
-				      const Method::SparseElimination     &)//M
+				      const Method::SparseElimination     &M)
 	{
 		commentator().start ("Sparse Elimination Rank over GF2", "serankmod2");
-		GaussDomain<GF2> GD ( A.field() );
+		GaussDomain<GF2> GD ( A.field(), M.denseSwitchDensity );
 		GD.rankInPlace (r, A, PivotStrategy::Linear);
 		commentator().stop ("done", NULL, "serankmod2");
 		return r;
@@ -614,9 +613,7 @@ namespace LinBox { /*  rankInPlace */
 	{
 
 		commentator().start ("BlasBB Rank", "blasbbrank");
-		const Field F = A.field();
-		BlasMatrixDomain<Field> D(F);
-		r = D.rankInPlace(static_cast< BlasMatrix<Field>& >(A));
+		r = Protected::blasRankInPlace(A);
 		commentator().stop ("done", NULL, "blasbbrank");
 		return r;
 	}
@@ -652,7 +649,7 @@ namespace LinBox { /*  rankInPlace */
 				      const Method::SparseElimination    &M)
 	{
 		commentator().start ("Sparse Elimination Rank", "serank");
-		GaussDomain<typename Blackbox::Field> GD (A.field());
+		GaussDomain<typename Blackbox::Field> GD (A.field(), M.denseSwitchDensity);
 		GD.rankInPlace( r, A, M.pivotStrategy);
 		commentator().stop ("done", NULL, "serank");
 		return r;
@@ -100,6 +100,7 @@ namespace LinBox {
      *      - Otherwise  > Error
      * - Method::BlockLanczos
      *      - ModularTag > `MGBlockLanczosSolver`
+     *      - ModularTag, ZeroOne<GF2> > `BlockLanczosGF2`
      *      - Otherwise  > Error
      * - Method::SymbolicNumericOverlap
      *      - IntegerTag
@@ -22,6 +22,7 @@
 
 #include <linbox/algorithms/lanczos.h>
 #include <linbox/algorithms/mg-block-lanczos.h>
+#include <linbox/algorithms/block-lanczos-gf2.h>
 
 namespace LinBox {
     //
@@ -80,4 +81,24 @@ namespace LinBox {
 
         return x;
     }
+
+    /**
+     * \brief Solve specialisation for BlockLanczos on sparse matrices over GF2,
+     * with the word-packed BlockLanczosGF2.
+     */
+    template <class Vector>
+    Vector& solve(Vector& x, const ZeroOne<GF2>& A, const Vector& b, const RingCategories::ModularTag& tag,
+                  const Method::BlockLanczos& m)
+    {
+        GF2 F2;
+        BlockLanczosGF2 solver(F2, m);
+
+        bool solveResult = solver.solve(A, x, b);
+
+        if (!solveResult) {
+            throw LinboxMathInconsistentSystem("From BlockLanczos solve over GF2.");
+        }
+
+        return x;
+    }
 }
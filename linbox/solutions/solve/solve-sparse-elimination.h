@@ -73,7 +73,7 @@ namespace LinBox {
         linbox_check((A.coldim() == x.size()) && (A.rowdim() == b.size()));
 
         using Field = typename SparseMatrix<MatrixArgs...>::Field;
-        GaussDomain<Field> gaussDomain(A.field());
+        GaussDomain<Field> gaussDomain(A.field(), m.denseSwitchDensity);
         gaussDomain.solveInPlace(x, A, b);
 
         commentator().stop("solve-in-place.sparse-elimination.any.sparse");
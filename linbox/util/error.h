@@ -84,6 +84,12 @@ namespace LinBox {
             : LinboxMathError(msg){};
     };
 
+    class LinboxMathSingularMatrix : public LinboxMathError {
+    public:
+        LinboxMathSingularMatrix(const char* msg)
+            : LinboxMathError(msg){};
+    };
+
     // -- Exception thrown in input of data structure
     class LinboxBadFormat : public LinboxError {
     public:
@@ -27,6 +27,8 @@
 #ifndef __LINBOX_util_field_axpy_H
 #define __LINBOX_util_field_axpy_H
 
+#include <cstddef>
+
 // Namespace in which all LinBox library code resides
 namespace LinBox
 {
@@ -116,6 +118,55 @@ namespace LinBox
 
 	}; // class FieldAXPY
 
+	/** Dot product of a sparse row with a dense vector.
+	 *
+	 * The row is given either by iterators on its values and column
+	 * indices (rows of the CSR, ELL and ELLR formats) or by an iterator on
+	 * (index, value) pairs (SparseSeq rows).  The result is normalized.
+	 *
+	 * This default instance accumulates with a FieldAXPY.  Fields for which
+	 * a known number of products can be summed without any reduction
+	 * specialize it with branch free kernels reducing once per block of
+	 * products (see ring/modular/modular-delayed.h).
+	 *
+	 * @param Field \ref LinBox @link Fields field@endlink
+	 */
+	template <class Field>
+	class SparseRowDot {
+	    public:
+		typedef typename Field::Element Element;
+
+		SparseRowDot (const Field &F) :
+			_accu (F)
+		{}
+
+		//! y = sum_k val[k] x[col[k]], 0 <= k < n
+		template <class ValIterator, class ColIterator, class Vector>
+		inline Element &operator() (Element &y, ValIterator val, ColIterator col, size_t n, const Vector &x)
+		{
+			_accu.reset ();
+			for (size_t k = 0; k < n; ++k, ++val, ++col)
+				_accu.mulacc (*val, x[*col]);
+			return _accu.get (y);
+		}
+
+		//! y = sum of it->second x[it->first] over the \p n pairs starting at \p it
+		template <class PairIterator, class Vector>
+		inline Element &pairs (Element &y, PairIterator it, size_t n, const Vector &x)
+		{
+			_accu.reset ();
+			for (size_t k = 0; k < n; ++k, ++it)
+				_accu.mulacc (it->second, x[it->first]);
+			return _accu.get (y);
+		}
+
+		inline const Field& field() const { return _accu.field (); }
+
+	    protected:
+		FieldAXPY<Field> _accu;
+
+	}; // class SparseRowDot
+
 } // namespace LinBox
 
 #endif // __LINBOX_util_field_axpy_H
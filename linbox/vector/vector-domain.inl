@@ -2101,15 +2101,8 @@ namespace LinBox
 	 VectorCategories::SparseSequenceVectorTag  ,
 	 VectorCategories::DenseVectorTag           ) const
 	{
-		typename Vector1::const_iterator i;
-
-		FieldAXPY<Field> accu(field());
-		//VectorDomainBase<Field>::accu.reset();
-
-		for (i = v1.begin (); i != v1.end (); ++i)
-			/*VectorDomainBase<Field>::*/accu.mulacc (i->second, v2[i->first]);
-
-		return /*VectorDomainBase<Field>::*/accu.get (res);
+		SparseRowDot<Field> dot(field());
+		return dot.pairs (res, v1.begin (), v1.size (), v2);
 	}
 
 	template <class Field>
@@ -100,6 +100,27 @@ bool testRankMethods(const typename BlackBox::Field & F, size_t n, size_t m, uns
 		commentator().report ()
 			<< endl << "elimination rank " << rank_elimination << endl;
 
+		// Purely sparse, then switching early to dense
+		size_t rank_sparse, rank_switch;
+		Method::SparseElimination MSE;
+		MSE.denseSwitchDensity = 0.;
+		LinBox::rank (rank_sparse, A, MSE);
+		MSE.denseSwitchDensity = sparsity;
+		LinBox::rank (rank_switch, A, MSE);
+		commentator().report ()
+			<< endl << "sparse elimination rank " << rank_sparse
+			<< ", with dense switch " << rank_switch << endl;
+		equalRank = equalRank and rank_sparse == rank_elimination
+			and rank_switch == rank_elimination;
+
+		// Structured pre-pass before sparse elimination
+		size_t rank_structured;
+		MSE.pivotStrategy = PivotStrategy::Structured;
+		LinBox::rank (rank_structured, A, MSE);
+		commentator().report ()
+			<< endl << "structured sparse elimination rank " << rank_structured << endl;
+		equalRank = equalRank and rank_structured == rank_elimination;
+
 #if 1
 		Method::Blackbox MB;
 		LinBox::rank (rank_blackbox, A, MB);